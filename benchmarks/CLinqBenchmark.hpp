@@ -0,0 +1,292 @@
+/// @file CLinqBenchmark.hpp
+/// A small timing harness for the CLinq benchmarks.
+///
+/// Each benchmark case is timed for a CLinq implementation and, optionally,
+/// for an equivalent baseline written with std::ranges or the standard
+/// algorithms. Results are reported in nanoseconds per input element together
+/// with the number of bytes allocated per run.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Totals for every allocation made through the global operator new.
+/// Defined in CLinqBenchmarkAllocations.cpp.
+struct CLinqBenchmarkAllocations
+{
+    static std::atomic<std::size_t> Bytes;
+    static std::atomic<std::size_t> Count;
+};
+
+/// Prevents the compiler from optimising away the computation of a value.
+/// @tparam T The type of value.
+/// @param value The value which must be considered observed.
+template <typename T>
+inline void CLinqBenchmarkSink(T const& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static void const* volatile sink;
+    sink = &value;
+#endif
+}
+
+/// Options controlling which benchmarks run and how they are reported.
+struct CLinqBenchmarkOptions
+{
+    /// Only benchmarks whose "Operator/type" name contains this are run.
+    std::string filter;
+
+    /// Element types to benchmark. Empty means all of them.
+    std::vector<std::string> types;
+
+    std::size_t minimumSize = 100;
+    std::size_t maximumSize = 10'000'000;
+
+    /// The minimum time to spend measuring each implementation.
+    std::chrono::milliseconds minimumTime{100};
+
+    /// Whether to time the std::ranges baseline alongside CLinq.
+    bool compare = true;
+
+    /// Whether to print comma separated values instead of a table.
+    bool csv = false;
+
+    /// Whether usage information was requested.
+    bool help = false;
+
+    /// Parses options from the command line.
+    /// @param argc The number of arguments.
+    /// @param argv The arguments.
+    /// @returns The parsed options.
+    /// @throws std::invalid_argument If an argument is not recognised.
+    static CLinqBenchmarkOptions Parse(int const argc, char const* const* const argv)
+    {
+        CLinqBenchmarkOptions options;
+
+        for (auto i = 1; i < argc; ++i)
+        {
+            std::string_view const argument = argv[i];
+            auto const next = [&]() -> std::string
+            {
+                if (i + 1 >= argc)
+                {
+                    throw std::invalid_argument("Missing value for " + std::string(argument) + ".");
+                }
+
+                return argv[++i];
+            };
+
+            if (argument == "--filter")
+            {
+                options.filter = next();
+            }
+            else if (argument == "--types")
+            {
+                auto const value = next();
+                std::size_t start = 0;
+
+                while (start <= value.size())
+                {
+                    auto const end = std::min(value.find(',', start), value.size());
+                    options.types.push_back(value.substr(start, end - start));
+                    start = end + 1;
+                }
+            }
+            else if (argument == "--min-size")
+            {
+                options.minimumSize = std::stoull(next());
+            }
+            else if (argument == "--max-size")
+            {
+                options.maximumSize = std::stoull(next());
+            }
+            else if (argument == "--min-time")
+            {
+                options.minimumTime = std::chrono::milliseconds(std::stoll(next()));
+            }
+            else if (argument == "--no-compare")
+            {
+                options.compare = false;
+            }
+            else if (argument == "--csv")
+            {
+                options.csv = true;
+            }
+            else if (argument == "--help" || argument == "-h")
+            {
+                options.help = true;
+            }
+            else
+            {
+                throw std::invalid_argument("Unknown argument " + std::string(argument) + ".");
+            }
+        }
+
+        return options;
+    }
+
+    /// Prints usage information.
+    static void PrintUsage()
+    {
+        std::puts(
+            "Usage: CLinqBenchmarks [options]\n"
+            "  --filter <text>     Run benchmarks whose \"Operator/type\" name contains text.\n"
+            "  --types <list>      Comma separated element types: int,double,string,payload.\n"
+            "  --min-size <n>      Smallest collection size (default 100).\n"
+            "  --max-size <n>      Largest collection size (default 10000000).\n"
+            "  --min-time <ms>     Minimum time spent measuring each case (default 100).\n"
+            "  --no-compare        Do not time the std::ranges baselines.\n"
+            "  --csv               Print comma separated values.");
+    }
+
+    /// Determines whether an element type was selected.
+    /// @param type The name of the element type.
+    /// @returns True if the type should be benchmarked.
+    bool IncludesType(std::string_view const type) const
+    {
+        return types.empty() || std::find(types.begin(), types.end(), type) != types.end();
+    }
+
+    /// Determines whether a benchmark was selected.
+    /// @param name The "Operator/type" name of the benchmark.
+    /// @returns True if the benchmark should run.
+    bool Includes(std::string_view const name) const
+    {
+        return name.find(filter) != std::string_view::npos;
+    }
+};
+
+/// The cost of running a single implementation of a benchmark.
+struct CLinqBenchmarkMeasurement
+{
+    double nanosecondsPerElement = 0;
+    double bytesPerRun = 0;
+    double allocationsPerRun = 0;
+};
+
+/// Times a function until the minimum time has elapsed.
+/// @param function The function to time.
+/// @param elements The number of input elements processed by each run.
+/// @param minimumTime The minimum time to spend measuring.
+/// @returns The measurement.
+inline CLinqBenchmarkMeasurement CLinqBenchmarkMeasure(
+    std::function<void()> const& function,
+    std::size_t const elements,
+    std::chrono::nanoseconds const minimumTime)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // A warm up run faults in any memory the function touches for the first time.
+    function();
+
+    auto const bytesBefore = CLinqBenchmarkAllocations::Bytes.load(std::memory_order_relaxed);
+    auto const countBefore = CLinqBenchmarkAllocations::Count.load(std::memory_order_relaxed);
+    auto const start = Clock::now();
+    auto elapsed = Clock::duration::zero();
+    std::size_t runs = 0;
+
+    do
+    {
+        function();
+        ++runs;
+        elapsed = Clock::now() - start;
+    } while (elapsed < minimumTime);
+
+    auto const bytes = CLinqBenchmarkAllocations::Bytes.load(std::memory_order_relaxed) - bytesBefore;
+    auto const count = CLinqBenchmarkAllocations::Count.load(std::memory_order_relaxed) - countBefore;
+    auto const nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count();
+
+    return CLinqBenchmarkMeasurement{
+        nanoseconds / static_cast<double>(runs * std::max<std::size_t>(elements, 1)),
+        static_cast<double>(bytes) / static_cast<double>(runs),
+        static_cast<double>(count) / static_cast<double>(runs)};
+}
+
+/// Prints benchmark results as they are produced.
+class CLinqBenchmarkReporter final
+{
+    public:
+        /// Constructs a new reporter and prints the header.
+        /// @param options The benchmark options.
+        explicit CLinqBenchmarkReporter(CLinqBenchmarkOptions const& options)
+            : _options(options)
+        {
+            if (_options.csv)
+            {
+                std::puts("benchmark,type,size,clinq_ns_per_element,clinq_bytes_per_run,clinq_allocations_per_run,"
+                    "baseline_ns_per_element,baseline_bytes_per_run,baseline_allocations_per_run");
+            }
+            else
+            {
+                std::printf("%-28s %-8s %10s %12s %14s %12s %14s %8s\n",
+                    "Benchmark", "Type", "Size", "CLinq ns/el", "CLinq B/run", "std ns/el", "std B/run", "Ratio");
+            }
+        }
+
+        /// Prints the result of a benchmark.
+        /// @param name The name of the operator.
+        /// @param type The name of the element type.
+        /// @param size The number of input elements.
+        /// @param clinq The measurement of the CLinq implementation.
+        /// @param baseline The measurement of the baseline, if one was timed.
+        void Report(
+            std::string_view const name,
+            std::string_view const type,
+            std::size_t const size,
+            CLinqBenchmarkMeasurement const& clinq,
+            CLinqBenchmarkMeasurement const* const baseline) const
+        {
+            if (_options.csv)
+            {
+                std::printf("%.*s,%.*s,%zu,%.4f,%.0f,%.1f,",
+                    static_cast<int>(name.size()), name.data(),
+                    static_cast<int>(type.size()), type.data(),
+                    size, clinq.nanosecondsPerElement, clinq.bytesPerRun, clinq.allocationsPerRun);
+
+                if (baseline != nullptr)
+                {
+                    std::printf("%.4f,%.0f,%.1f\n",
+                        baseline->nanosecondsPerElement, baseline->bytesPerRun, baseline->allocationsPerRun);
+                }
+                else
+                {
+                    std::puts(",,");
+                }
+
+                return;
+            }
+
+            std::printf("%-28.*s %-8.*s %10zu %12.3f %14.0f",
+                static_cast<int>(name.size()), name.data(),
+                static_cast<int>(type.size()), type.data(),
+                size, clinq.nanosecondsPerElement, clinq.bytesPerRun);
+
+            if (baseline != nullptr)
+            {
+                auto const ratio = baseline->nanosecondsPerElement > 0
+                    ? clinq.nanosecondsPerElement / baseline->nanosecondsPerElement
+                    : 0.0;
+
+                std::printf(" %12.3f %14.0f %7.2fx\n", baseline->nanosecondsPerElement, baseline->bytesPerRun, ratio);
+            }
+            else
+            {
+                std::printf(" %12s %14s %8s\n", "-", "-", "-");
+            }
+        }
+
+    private:
+        CLinqBenchmarkOptions const& _options;
+};
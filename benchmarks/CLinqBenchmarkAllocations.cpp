@@ -0,0 +1,117 @@
+/// @file CLinqBenchmarkAllocations.cpp
+/// Replaces the global allocation functions so that the benchmarks can report
+/// how many bytes each operator allocates.
+
+#include <cstdlib>
+#include <new>
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+#include "CLinqBenchmark.hpp"
+
+std::atomic<std::size_t> CLinqBenchmarkAllocations::Bytes{0};
+std::atomic<std::size_t> CLinqBenchmarkAllocations::Count{0};
+
+namespace
+{
+    void* Allocate(std::size_t const size, std::size_t const alignment)
+    {
+        CLinqBenchmarkAllocations::Bytes.fetch_add(size, std::memory_order_relaxed);
+        CLinqBenchmarkAllocations::Count.fetch_add(1, std::memory_order_relaxed);
+
+        auto const bytes = size == 0 ? 1 : size;
+#if defined(_MSC_VER)
+        // MSVC has no std::aligned_alloc, as its aligned memory must be freed with _aligned_free.
+        auto* const memory = alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__
+            ? std::malloc(bytes)
+            : _aligned_malloc(bytes, alignment);
+#else
+        auto* const memory = alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__
+            ? std::malloc(bytes)
+            : std::aligned_alloc(alignment, (bytes + alignment - 1) / alignment * alignment);
+#endif
+
+        if (memory == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        return memory;
+    }
+
+    void Free(void* const memory, std::size_t const alignment) noexcept
+    {
+#if defined(_MSC_VER)
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+            _aligned_free(memory);
+
+            return;
+        }
+#else
+        static_cast<void>(alignment);
+#endif
+
+        std::free(memory);
+    }
+}
+
+void* operator new(std::size_t const size)
+{
+    return Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](std::size_t const size)
+{
+    return Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(std::size_t const size, std::align_val_t const alignment)
+{
+    return Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t const size, std::align_val_t const alignment)
+{
+    return Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* const memory) noexcept
+{
+    Free(memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete[](void* const memory) noexcept
+{
+    Free(memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete(void* const memory, std::size_t) noexcept
+{
+    Free(memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete[](void* const memory, std::size_t) noexcept
+{
+    Free(memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete(void* const memory, std::align_val_t const alignment) noexcept
+{
+    Free(memory, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* const memory, std::align_val_t const alignment) noexcept
+{
+    Free(memory, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* const memory, std::size_t, std::align_val_t const alignment) noexcept
+{
+    Free(memory, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* const memory, std::size_t, std::align_val_t const alignment) noexcept
+{
+    Free(memory, static_cast<std::size_t>(alignment));
+}
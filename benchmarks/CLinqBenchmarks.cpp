@@ -0,0 +1,988 @@
+/// @file CLinqBenchmarks.cpp
+/// Benchmarks for the CLinqCollection operators.
+///
+/// Every operator is timed over int, double, std::string and a 64 byte struct
+/// for collection sizes from 100 to 10,000,000 elements. Where the standard
+/// library has an equivalent, the same work is also timed using std::ranges
+/// views or the standard algorithms over the same elements, so that the ratio
+/// column shows where CLinq is slower than the hand written pipeline.
+
+#include <charconv>
+#include <compare>
+#include <iterator>
+#include <list>
+#include <map>
+#include <numeric>
+#include <ranges>
+#include <set>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include "CLinq.hpp"
+#include "CLinqBenchmark.hpp"
+
+/// A 64 byte element, large enough that copies rather than comparisons dominate.
+struct CLinqBenchmarkPayload
+{
+    std::int64_t key;
+    std::int64_t values[7];
+
+    auto operator<=>(CLinqBenchmarkPayload const&) const = default;
+};
+
+static_assert(sizeof(CLinqBenchmarkPayload) == 64);
+
+template <>
+struct std::hash<CLinqBenchmarkPayload>
+{
+    std::size_t operator()(CLinqBenchmarkPayload const& payload) const noexcept
+    {
+        return std::hash<std::int64_t>{}(payload.key);
+    }
+};
+
+/// The prefix given to string elements, long enough to defeat the small string optimisation.
+static constexpr std::string_view StringPrefix = "clinq-benchmark-";
+
+/// Creates the element with the given key.
+template <typename T>
+static T MakeElement(std::int64_t const key)
+{
+    if constexpr (std::is_same_v<T, std::string>)
+    {
+        return std::string(StringPrefix) + std::to_string(key);
+    }
+    else if constexpr (std::is_same_v<T, CLinqBenchmarkPayload>)
+    {
+        return CLinqBenchmarkPayload{key, {key, key, key, key, key, key, key}};
+    }
+    else
+    {
+        return static_cast<T>(key);
+    }
+}
+
+/// Recovers the key an element was created from.
+struct KeyOf
+{
+    std::int64_t operator()(std::string const& element) const noexcept
+    {
+        std::int64_t key = 0;
+        std::from_chars(element.data() + StringPrefix.size(), element.data() + element.size(), key);
+        return key;
+    }
+
+    std::int64_t operator()(CLinqBenchmarkPayload const& element) const noexcept
+    {
+        return element.key;
+    }
+
+    template <typename T>
+    std::int64_t operator()(T const element) const noexcept
+    {
+        return static_cast<std::int64_t>(element);
+    }
+};
+
+/// Scrambles the key of an element, so that sorting by it shuffles the otherwise ordered input.
+struct ScrambledKeyOf
+{
+    template <typename T>
+    std::uint64_t operator()(T const& element) const noexcept
+    {
+        return static_cast<std::uint64_t>(KeyOf{}(element)) * 0x9E3779B97F4A7C15ull;
+    }
+};
+
+/// Assigns elements to one of 1024 groups.
+struct GroupKeyOf
+{
+    template <typename T>
+    std::uint64_t operator()(T const& element) const noexcept
+    {
+        return ScrambledKeyOf{}(element) >> 54;
+    }
+};
+
+/// The number of elements taken by the TopBy benchmark.
+constexpr std::size_t TopCount = 100;
+
+/// The number of elements in each chunk of the Chunk benchmark.
+constexpr std::size_t ChunkSize = 512;
+
+/// The number of elements in each window of the Window benchmarks.
+constexpr std::size_t WindowSize = 60;
+
+/// The input shared by every benchmark of a given element type and size.
+/// Keys increase monotonically and roughly a quarter of them are duplicated.
+/// The second collection overlaps the first for half of its elements.
+template <typename T>
+struct CLinqBenchmarkInput
+{
+    explicit CLinqBenchmarkInput(std::size_t const size)
+        : size(size),
+          pivot(static_cast<std::int64_t>(size / 2 * 3 / 4)),
+          missing(MakeElement<T>(-1)),
+          single(CLinqCollection<T>::Repeat(MakeElement<T>(0), 1))
+    {
+        auto first = std::vector<T>();
+        auto second = std::vector<T>();
+        first.reserve(size);
+        second.reserve(size);
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            first.push_back(MakeElement<T>(static_cast<std::int64_t>(i * 3 / 4)));
+            second.push_back(MakeElement<T>(static_cast<std::int64_t>((i + size / 2) * 3 / 4)));
+        }
+
+        collection = CLinqCollection<T>(std::move(first));
+        other = CLinqCollection<T>(std::move(second));
+        elements = std::span<T const>(collection.AsView().begin(), collection.AsView().end());
+        otherElements = std::span<T const>(other.AsView().begin(), other.AsView().end());
+    }
+
+    CLinqBenchmarkInput(CLinqBenchmarkInput const&) = delete;
+    CLinqBenchmarkInput& operator=(CLinqBenchmarkInput const&) = delete;
+
+    std::size_t size;
+    std::int64_t pivot;
+    T missing;
+    CLinqCollection<T> collection;
+    CLinqCollection<T> other;
+
+    /// A collection of one element, for Single.
+    CLinqCollection<T> single;
+
+    /// The same elements as the collections, for the baselines.
+    std::span<T const> elements;
+    std::span<T const> otherElements;
+
+    bool IsEven(T const& element) const noexcept { return KeyOf{}(element) % 2 == 0; }
+    bool IsBeforePivot(T const& element) const noexcept { return KeyOf{}(element) < pivot; }
+    bool IsNegative(T const& element) const noexcept { return KeyOf{}(element) < 0; }
+    bool IsNonNegative(T const& element) const noexcept { return KeyOf{}(element) >= 0; }
+};
+
+/// A benchmark of a single operator.
+template <typename T>
+struct CLinqBenchmarkCase
+{
+    std::string_view name;
+    std::function<void(CLinqBenchmarkInput<T> const&)> clinq;
+
+    /// The equivalent standard library pipeline, or empty if there is none.
+    std::function<void(CLinqBenchmarkInput<T> const&)> baseline;
+};
+
+/// Copies a range into a vector, as a CLinq operator would.
+template <std::ranges::input_range TRange>
+static auto Materialise(TRange&& range)
+{
+    auto result = std::vector<std::ranges::range_value_t<TRange>>();
+
+    if constexpr (std::ranges::sized_range<TRange>)
+    {
+        result.reserve(std::ranges::size(range));
+    }
+
+    std::ranges::copy(range, std::back_inserter(result));
+
+    return result;
+}
+
+/// Copies the distinct elements of the ranges into a vector, in order of first appearance.
+template <typename T>
+static std::vector<T> DistinctElements(std::initializer_list<std::span<T const>> const ranges)
+{
+    auto seen = std::unordered_set<T>();
+    auto result = std::vector<T>();
+
+    for (auto const range : ranges)
+    {
+        for (auto const& element : range)
+        {
+            if (seen.insert(element).second)
+            {
+                result.push_back(element);
+            }
+        }
+    }
+
+    return result;
+}
+
+/// Copies the elements of a range which are, or are not, in another range.
+template <typename T>
+static std::vector<T> FilterByMembership(std::span<T const> const range, std::span<T const> const other, bool const keep)
+{
+    auto const members = std::unordered_set<T>(other.begin(), other.end());
+    auto result = std::vector<T>();
+
+    for (auto const& element : range)
+    {
+        if (members.contains(element) == keep)
+        {
+            result.push_back(element);
+        }
+    }
+
+    return result;
+}
+
+/// Gets the benchmarks for an element type.
+template <typename T>
+static std::vector<CLinqBenchmarkCase<T>> MakeCases()
+{
+    namespace views = std::views;
+    using Input = CLinqBenchmarkInput<T>;
+
+    auto cases = std::vector<CLinqBenchmarkCase<T>>{
+        {
+            "Aggregate",
+            [](Input const& in)
+            {
+                CLinqBenchmarkSink(in.collection.Aggregate(std::int64_t{0}, [](std::int64_t const sum, T const& e) { return sum + KeyOf{}(e); }));
+            },
+            [](Input const& in)
+            {
+                CLinqBenchmarkSink(std::accumulate(in.elements.begin(), in.elements.end(), std::int64_t{0},
+                    [](std::int64_t const sum, T const& e) { return sum + KeyOf{}(e); }));
+            }
+        },
+        {
+            "All",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.All([&](T const& e) { return in.IsNonNegative(e); })); },
+            [](Input const& in) { CLinqBenchmarkSink(std::ranges::all_of(in.elements, [&](T const& e) { return in.IsNonNegative(e); })); }
+        },
+        {
+            "Any",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Any([&](T const& e) { return in.IsNegative(e); })); },
+            [](Input const& in) { CLinqBenchmarkSink(std::ranges::any_of(in.elements, [&](T const& e) { return in.IsNegative(e); })); }
+        },
+        {
+            "Append",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Append(in.missing)); },
+            [](Input const& in)
+            {
+                auto result = std::vector<T>();
+                result.reserve(in.size + 1);
+                result.assign(in.elements.begin(), in.elements.end());
+                result.push_back(in.missing);
+                CLinqBenchmarkSink(result);
+            }
+        },
+        {
+            "Arena.Where.Select",
+            [](Input const& in)
+            {
+                // The arena is reused across runs, so after the first run its block is large enough
+                // that nothing is allocated from the heap.
+                static auto arena = CLinqArena();
+                arena.Release();
+
+                CLinqBenchmarkSink(in.collection.AsQuery()
+                    .Where([&](T const& e) { return in.IsEven(e); })
+                    .ToCollection(CLinqArenaAllocator<T>(arena))
+                    .Select(KeyOf{}));
+            },
+            [](Input const& in)
+            {
+                CLinqBenchmarkSink(Materialise(in.elements
+                    | views::filter([&](T const& e) { return in.IsEven(e); })
+                    | views::transform(KeyOf{})));
+            }
+        },
+        {
+            "AsParallel.Aggregate",
+            [](Input const& in)
+            {
+                CLinqBenchmarkSink(in.collection.AsParallel().Aggregate(
+                    std::int64_t{0},
+                    [](std::int64_t const sum, T const& e) { return sum + KeyOf{}(e); },
+                    std::plus<>()));
+            },
+            [](Input const& in)
+            {
+                CLinqBenchmarkSink(std::accumulate(in.elements.begin(), in.elements.end(), std::int64_t{0},
+                    [](std::int64_t const sum, T const& e) { return sum + KeyOf{}(e); }));
+            }
+        },
+        {
+            "AsParallel.Where",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.AsParallel().Where([&](T const& e) { return in.IsEven(e); }).ToVector()); },
+            [](Input const& in) { CLinqBenchmarkSink(Materialise(in.elements | views::filter([&](T const& e) { return in.IsEven(e); }))); }
+        },
+        {
+            "AsQuery.Where.Select",
+            [](Input const& in)
+            {
+                CLinqBenchmarkSink(in.collection.AsQuery()
+                    .Where([&](T const& e) { return in.IsEven(e); })
+                    .Select(KeyOf{})
+                    .ToVector());
+            },
+            [](Input const& in)
+            {
+                CLinqBenchmarkSink(Materialise(in.elements
+                    | views::filter([&](T const& e) { return in.IsEven(e); })
+                    | views::transform(KeyOf{})));
+            }
+        },
+        {
+            "At",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.At(in.size / 2)); },
+            [](Input const& in) { CLinqBenchmarkSink(in.elements[in.size / 2]); }
+        },
+        {
+            "Chunk",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Chunk(ChunkSize)); },
+            [](Input const& in)
+            {
+                auto result = std::vector<std::vector<T>>();
+                for (std::size_t offset = 0; offset < in.size; offset += ChunkSize)
+                {
+                    auto const chunk = in.elements.subspan(offset, std::min(ChunkSize, in.size - offset));
+                    result.emplace_back(chunk.begin(), chunk.end());
+                }
+                CLinqBenchmarkSink(result);
+            }
+        },
+        {
+            "Concat",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Concat(in.other)); },
+            [](Input const& in)
+            {
+                auto result = std::vector<T>();
+                result.reserve(in.elements.size() + in.otherElements.size());
+                result.insert(result.end(), in.elements.begin(), in.elements.end());
+                result.insert(result.end(), in.otherElements.begin(), in.otherElements.end());
+                CLinqBenchmarkSink(result);
+            }
+        },
+        {
+            "Contains",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Contains(in.missing)); },
+            [](Input const& in) { CLinqBenchmarkSink(std::ranges::find(in.elements, in.missing) != in.elements.end()); }
+        },
+        {
+            "Count",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Count([&](T const& e) { return in.IsEven(e); })); },
+            [](Input const& in) { CLinqBenchmarkSink(std::ranges::count_if(in.elements, [&](T const& e) { return in.IsEven(e); })); }
+        },
+        {
+            "Distinct",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Distinct()); },
+            [](Input const& in) { CLinqBenchmarkSink(DistinctElements<T>({in.elements})); }
+        },
+        {
+            "Except",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Except(in.other)); },
+            [](Input const& in) { CLinqBenchmarkSink(FilterByMembership<T>(in.elements, in.otherElements, false)); }
+        },
+        {
+            "First",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.First()); },
+            [](Input const& in) { CLinqBenchmarkSink(in.elements.front()); }
+        },
+        {
+            "GroupBy",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.GroupBy(GroupKeyOf{})); },
+            [](Input const& in)
+            {
+                auto groups = std::unordered_map<std::uint64_t, std::vector<T>>();
+                for (auto const& element : in.elements)
+                {
+                    groups[GroupKeyOf{}(element)].push_back(element);
+                }
+
+                CLinqBenchmarkSink(groups);
+            }
+        },
+        {
+            "GroupJoin",
+            [](Input const& in)
+            {
+                CLinqBenchmarkSink(in.collection.GroupJoin(in.other, KeyOf{}, KeyOf{},
+                    [](T const&, CLinqView<T> const matches) { return matches.Count(); }));
+            },
+            [](Input const& in)
+            {
+                auto index = std::unordered_multimap<std::int64_t, T const*>();
+                for (auto const& element : in.otherElements)
+                {
+                    index.emplace(KeyOf{}(element), &element);
+                }
+
+                auto result = std::vector<std::size_t>();
+                result.reserve(in.elements.size());
+                for (auto const& element : in.elements)
+                {
+                    result.push_back(index.count(KeyOf{}(element)));
+                }
+
+                CLinqBenchmarkSink(result);
+            }
+        },
+        {
+            "Intersection",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Intersection(in.other)); },
+            [](Input const& in) { CLinqBenchmarkSink(FilterByMembership<T>(in.elements, in.otherElements, true)); }
+        },
+        {
+            "Join",
+            [](Input const& in)
+            {
+                CLinqBenchmarkSink(in.collection.Join(in.other, KeyOf{}, KeyOf{},
+                    [](T const& left, T const& right) { return KeyOf{}(left) + KeyOf{}(right); }));
+            },
+            [](Input const& in)
+            {
+                auto index = std::unordered_multimap<std::int64_t, T const*>();
+                for (auto const& element : in.otherElements)
+                {
+                    index.emplace(KeyOf{}(element), &element);
+                }
+
+                auto result = std::vector<std::int64_t>();
+                for (auto const& element : in.elements)
+                {
+                    auto const [first, last] = index.equal_range(KeyOf{}(element));
+                    for (auto match = first; match != last; ++match)
+                    {
+                        result.push_back(KeyOf{}(element) + KeyOf{}(*match->second));
+                    }
+                }
+
+                CLinqBenchmarkSink(result);
+            }
+        },
+        {
+            "Last",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Last()); },
+            [](Input const& in) { CLinqBenchmarkSink(in.elements.back()); }
+        },
+        {
+            "Max",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Max()); },
+            [](Input const& in) { CLinqBenchmarkSink(std::ranges::max(in.elements)); }
+        },
+        {
+            "MaxBy",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.MaxBy(KeyOf{})); },
+            [](Input const& in) { CLinqBenchmarkSink(*std::ranges::max_element(in.elements, {}, KeyOf{})); }
+        },
+        {
+            "Min",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Min()); },
+            [](Input const& in) { CLinqBenchmarkSink(std::ranges::min(in.elements)); }
+        },
+        {
+            "MinBy",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.MinBy(KeyOf{})); },
+            [](Input const& in) { CLinqBenchmarkSink(*std::ranges::min_element(in.elements, {}, KeyOf{})); }
+        },
+        {
+            "OrderBy",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.OrderBy(ScrambledKeyOf{})); },
+            [](Input const& in)
+            {
+                auto result = std::vector<T>(in.elements.begin(), in.elements.end());
+                std::ranges::stable_sort(result, {}, ScrambledKeyOf{});
+                CLinqBenchmarkSink(result);
+            }
+        },
+        {
+            "OrderBy.ThenByDescending",
+            [](Input const& in)
+            {
+                CLinqBenchmarkSink(in.collection
+                    .OrderBy([](T const& e) { return KeyOf{}(e) % 16; })
+                    .ThenByDescending(ScrambledKeyOf{}));
+            },
+            [](Input const& in)
+            {
+                auto result = std::vector<T>(in.elements.begin(), in.elements.end());
+                std::ranges::stable_sort(result, [](T const& left, T const& right)
+                {
+                    auto const leftBucket = KeyOf{}(left) % 16;
+                    auto const rightBucket = KeyOf{}(right) % 16;
+                    return leftBucket != rightBucket ? leftBucket < rightBucket : ScrambledKeyOf{}(right) < ScrambledKeyOf{}(left);
+                });
+                CLinqBenchmarkSink(result);
+            }
+        },
+        {
+            "OrderBy.ThenBy",
+            [](Input const& in)
+            {
+                CLinqBenchmarkSink(in.collection
+                    .OrderBy([](T const& e) { return KeyOf{}(e) % 16; })
+                    .ThenBy(ScrambledKeyOf{}));
+            },
+            [](Input const& in)
+            {
+                auto result = std::vector<T>(in.elements.begin(), in.elements.end());
+                std::ranges::stable_sort(result, [](T const& left, T const& right)
+                {
+                    auto const leftBucket = KeyOf{}(left) % 16;
+                    auto const rightBucket = KeyOf{}(right) % 16;
+                    return leftBucket != rightBucket ? leftBucket < rightBucket : ScrambledKeyOf{}(left) < ScrambledKeyOf{}(right);
+                });
+                CLinqBenchmarkSink(result);
+            }
+        },
+        {
+            "OrderByDescending",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.OrderByDescending(ScrambledKeyOf{})); },
+            [](Input const& in)
+            {
+                auto result = std::vector<T>(in.elements.begin(), in.elements.end());
+                std::ranges::stable_sort(result, std::ranges::greater(), ScrambledKeyOf{});
+                CLinqBenchmarkSink(result);
+            }
+        },
+        {
+            "Prepend",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Prepend(in.missing)); },
+            [](Input const& in)
+            {
+                auto result = std::vector<T>();
+                result.reserve(in.size + 1);
+                result.push_back(in.missing);
+                result.insert(result.end(), in.elements.begin(), in.elements.end());
+                CLinqBenchmarkSink(result);
+            }
+        },
+        {
+            "Repeat",
+            [](Input const& in) { CLinqBenchmarkSink(CLinqCollection<T>::Repeat(in.missing, in.size)); },
+            [](Input const& in) { CLinqBenchmarkSink(std::vector<T>(in.size, in.missing)); }
+        },
+        {
+            "Reverse",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Reverse()); },
+            [](Input const& in) { CLinqBenchmarkSink(Materialise(in.elements | views::reverse)); }
+        },
+        {
+            "Select",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Select(KeyOf{})); },
+            [](Input const& in) { CLinqBenchmarkSink(Materialise(in.elements | views::transform(KeyOf{}))); }
+        },
+        {
+            "SelectMany",
+            [](Input const& in)
+            {
+                CLinqBenchmarkSink(in.collection.SelectMany([&](T const&) { return in.elements.first(std::min<std::size_t>(in.size, 4)); }));
+            },
+            [](Input const& in)
+            {
+                CLinqBenchmarkSink(Materialise(in.elements
+                    | views::transform([&](T const&) { return in.elements.first(std::min<std::size_t>(in.size, 4)); })
+                    | views::join));
+            }
+        },
+        {
+            "Single",
+            [](Input const& in) { CLinqBenchmarkSink(in.single.Single()); },
+            {}
+        },
+        {
+            "Skip",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Skip(in.size / 2)); },
+            [](Input const& in) { CLinqBenchmarkSink(Materialise(in.elements | views::drop(in.size / 2))); }
+        },
+        {
+            "SkipLast",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.SkipLast(in.size / 2)); },
+            [](Input const& in) { CLinqBenchmarkSink(Materialise(in.elements | views::take(in.size - in.size / 2))); }
+        },
+        {
+            "SkipWhile",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.SkipWhile([&](T const& e) { return in.IsBeforePivot(e); })); },
+            [](Input const& in) { CLinqBenchmarkSink(Materialise(in.elements | views::drop_while([&](T const& e) { return in.IsBeforePivot(e); }))); }
+        },
+        {
+            "Take",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Take(in.size / 2)); },
+            [](Input const& in) { CLinqBenchmarkSink(Materialise(in.elements | views::take(in.size / 2))); }
+        },
+        {
+            "TakeLast",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.TakeLast(in.size / 2)); },
+            [](Input const& in) { CLinqBenchmarkSink(Materialise(in.elements | views::drop(in.size - in.size / 2))); }
+        },
+        {
+            "TakeWhile",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.TakeWhile([&](T const& e) { return in.IsBeforePivot(e); })); },
+            [](Input const& in) { CLinqBenchmarkSink(Materialise(in.elements | views::take_while([&](T const& e) { return in.IsBeforePivot(e); }))); }
+        },
+        {
+            "ToFlatMap",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.ToFlatMap(ScrambledKeyOf{}, KeyOf{})); },
+            [](Input const& in)
+            {
+                auto map = std::unordered_map<decltype(ScrambledKeyOf{}(in.elements[0])), std::int64_t>();
+                map.reserve(in.elements.size());
+                for (auto const& element : in.elements)
+                {
+                    map.insert_or_assign(ScrambledKeyOf{}(element), KeyOf{}(element));
+                }
+
+                CLinqBenchmarkSink(map);
+            }
+        },
+        {
+            "ToHashSet",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.ToHashSet()); },
+            [](Input const& in) { CLinqBenchmarkSink(std::unordered_set<T>(in.elements.begin(), in.elements.end())); }
+        },
+        {
+            "ToList",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.ToList()); },
+            [](Input const& in) { CLinqBenchmarkSink(std::list<T>(in.elements.begin(), in.elements.end())); }
+        },
+        {
+            "ToLookup",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.ToLookup(GroupKeyOf{}, KeyOf{})); },
+            [](Input const& in)
+            {
+                auto groups = std::map<std::uint64_t, std::vector<std::int64_t>>();
+                for (auto const& element : in.elements)
+                {
+                    groups[GroupKeyOf{}(element)].push_back(KeyOf{}(element));
+                }
+
+                CLinqBenchmarkSink(groups);
+            }
+        },
+        {
+            "ToMap",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.template ToMap<std::int64_t, std::int64_t>(KeyOf{}, KeyOf{})); },
+            [](Input const& in)
+            {
+                auto map = std::map<std::int64_t, std::int64_t>();
+                for (auto const& element : in.elements)
+                {
+                    map.insert_or_assign(KeyOf{}(element), KeyOf{}(element));
+                }
+
+                CLinqBenchmarkSink(map);
+            }
+        },
+        {
+            "ToSet",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.ToSet()); },
+            [](Input const& in) { CLinqBenchmarkSink(std::set<T>(in.elements.begin(), in.elements.end())); }
+        },
+        {
+            "ToUnorderedMap",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.template ToUnorderedMap<std::int64_t, std::int64_t>(KeyOf{}, KeyOf{})); },
+            [](Input const& in)
+            {
+                auto map = std::unordered_map<std::int64_t, std::int64_t>();
+                map.reserve(in.elements.size());
+                for (auto const& element : in.elements)
+                {
+                    map.insert_or_assign(KeyOf{}(element), KeyOf{}(element));
+                }
+
+                CLinqBenchmarkSink(map);
+            }
+        },
+        {
+            "ToVector",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.ToVector()); },
+            [](Input const& in) { CLinqBenchmarkSink(std::vector<T>(in.elements.begin(), in.elements.end())); }
+        },
+        {
+            "TopBy",
+            [](Input const& in)
+            {
+                CLinqBenchmarkSink(in.collection.TopBy(ScrambledKeyOf{}, std::min<std::size_t>(TopCount, in.elements.size())));
+            },
+            [](Input const& in)
+            {
+                auto result = std::vector<T>(std::min<std::size_t>(TopCount, in.elements.size()));
+                std::ranges::partial_sort_copy(in.elements, result, {}, ScrambledKeyOf{}, ScrambledKeyOf{});
+                CLinqBenchmarkSink(result);
+            }
+        },
+        {
+            "TopByDescending",
+            [](Input const& in)
+            {
+                CLinqBenchmarkSink(in.collection.TopByDescending(ScrambledKeyOf{}, std::min<std::size_t>(TopCount, in.elements.size())));
+            },
+            [](Input const& in)
+            {
+                auto result = std::vector<T>(std::min<std::size_t>(TopCount, in.elements.size()));
+                std::ranges::partial_sort_copy(in.elements, result, std::ranges::greater(), ScrambledKeyOf{}, ScrambledKeyOf{});
+                CLinqBenchmarkSink(result);
+            }
+        },
+        {
+            "Union",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Union(in.other)); },
+            [](Input const& in) { CLinqBenchmarkSink(DistinctElements<T>({in.elements, in.otherElements})); }
+        },
+        {
+            "Where",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Where([&](T const& e) { return in.IsEven(e); })); },
+            [](Input const& in) { CLinqBenchmarkSink(Materialise(in.elements | views::filter([&](T const& e) { return in.IsEven(e); }))); }
+        },
+        {
+            "Window",
+            [](Input const& in) { CLinqBenchmarkSink(in.collection.Window(WindowSize)); },
+            [](Input const& in)
+            {
+                auto result = std::vector<std::span<T const>>();
+                for (std::size_t first = 0; first + WindowSize <= in.size; ++first)
+                {
+                    result.push_back(in.elements.subspan(first, WindowSize));
+                }
+                CLinqBenchmarkSink(result);
+            }
+        },
+        {
+            "Where.Select",
+            [](Input const& in)
+            {
+                CLinqBenchmarkSink(in.collection
+                    .Where([&](T const& e) { return in.IsEven(e); })
+                    .Select(KeyOf{}));
+            },
+            [](Input const& in)
+            {
+                CLinqBenchmarkSink(Materialise(in.elements
+                    | views::filter([&](T const& e) { return in.IsEven(e); })
+                    | views::transform(KeyOf{})));
+            }
+        }
+    };
+
+    if constexpr (std::is_arithmetic_v<T>)
+    {
+        cases.insert(cases.end(), {
+            {
+                "Average",
+                [](Input const& in) { CLinqBenchmarkSink(in.collection.Average()); },
+                [](Input const& in)
+                {
+                    CLinqBenchmarkSink(std::accumulate(in.elements.begin(), in.elements.end(), 0.0) / static_cast<double>(in.size));
+                }
+            },
+            {
+                "ExclusiveScan",
+                [](Input const& in) { CLinqBenchmarkSink(in.collection.ExclusiveScan(T{}, std::plus<>())); },
+                [](Input const& in)
+                {
+                    auto result = std::vector<T>(in.size);
+                    std::exclusive_scan(in.elements.begin(), in.elements.end(), result.begin(), T{});
+                    CLinqBenchmarkSink(result);
+                }
+            },
+            {
+                "Range",
+                [](Input const& in) { CLinqBenchmarkSink(CLinqCollection<T>::Range(T{}, in.size)); },
+                [](Input const& in)
+                {
+                    auto result = std::vector<T>(in.size);
+                    std::iota(result.begin(), result.end(), T{});
+                    CLinqBenchmarkSink(result);
+                }
+            },
+            {
+                "Scan",
+                [](Input const& in) { CLinqBenchmarkSink(in.collection.Scan(T{}, std::plus<>())); },
+                [](Input const& in)
+                {
+                    auto result = std::vector<T>(in.size);
+                    std::inclusive_scan(in.elements.begin(), in.elements.end(), result.begin());
+                    CLinqBenchmarkSink(result);
+                }
+            },
+            {
+                "AsParallel.Scan",
+                [](Input const& in) { CLinqBenchmarkSink(in.collection.AsParallel().Scan(T{}, std::plus<>()).ToVector()); },
+                [](Input const& in)
+                {
+                    auto result = std::vector<T>(in.size);
+                    std::inclusive_scan(in.elements.begin(), in.elements.end(), result.begin());
+                    CLinqBenchmarkSink(result);
+                }
+            },
+            {
+                "StaticCast",
+                [](Input const& in) { CLinqBenchmarkSink(in.collection.template StaticCast<std::int64_t>()); },
+                [](Input const& in)
+                {
+                    CLinqBenchmarkSink(Materialise(in.elements | views::transform([](T const e) { return static_cast<std::int64_t>(e); })));
+                }
+            },
+            {
+                "Sum",
+                [](Input const& in) { CLinqBenchmarkSink(in.collection.Sum()); },
+                [](Input const& in) { CLinqBenchmarkSink(std::accumulate(in.elements.begin(), in.elements.end(), T{})); }
+            },
+            {
+                "WindowAverage",
+                [](Input const& in) { CLinqBenchmarkSink(in.collection.WindowAverage(WindowSize)); },
+                [](Input const& in)
+                {
+                    auto result = std::vector<double>();
+                    for (std::size_t first = 0; first + WindowSize <= in.size; ++first)
+                    {
+                        auto const window = in.elements.subspan(first, WindowSize);
+                        result.push_back(std::accumulate(window.begin(), window.end(), 0.0) / static_cast<double>(WindowSize));
+                    }
+                    CLinqBenchmarkSink(result);
+                }
+            },
+            {
+                "WindowMax",
+                [](Input const& in) { CLinqBenchmarkSink(in.collection.WindowMax(WindowSize)); },
+                [](Input const& in)
+                {
+                    auto result = std::vector<T>();
+                    for (std::size_t first = 0; first + WindowSize <= in.size; ++first)
+                    {
+                        result.push_back(std::ranges::max(in.elements.subspan(first, WindowSize)));
+                    }
+                    CLinqBenchmarkSink(result);
+                }
+            },
+            {
+                "WindowMin",
+                [](Input const& in) { CLinqBenchmarkSink(in.collection.WindowMin(WindowSize)); },
+                [](Input const& in)
+                {
+                    auto result = std::vector<T>();
+                    for (std::size_t first = 0; first + WindowSize <= in.size; ++first)
+                    {
+                        result.push_back(std::ranges::min(in.elements.subspan(first, WindowSize)));
+                    }
+                    CLinqBenchmarkSink(result);
+                }
+            },
+            {
+                "WindowSum",
+                [](Input const& in) { CLinqBenchmarkSink(in.collection.WindowSum(WindowSize)); },
+                [](Input const& in)
+                {
+                    auto result = std::vector<T>();
+                    for (std::size_t first = 0; first + WindowSize <= in.size; ++first)
+                    {
+                        auto const window = in.elements.subspan(first, WindowSize);
+                        result.push_back(std::accumulate(window.begin(), window.end(), T{}));
+                    }
+                    CLinqBenchmarkSink(result);
+                }
+            },
+            {
+                "Zip",
+                [](Input const& in) { CLinqBenchmarkSink(in.collection.Zip(in.other, std::plus<>())); },
+                [](Input const& in)
+                {
+                    auto result = std::vector<T>(in.size);
+                    std::ranges::transform(in.elements, in.otherElements, result.begin(), std::plus<>());
+                    CLinqBenchmarkSink(result);
+                }
+            }
+        });
+    }
+
+    std::ranges::sort(cases, {}, &CLinqBenchmarkCase<T>::name);
+
+    return cases;
+}
+
+/// Runs the benchmarks for an element type at every selected size.
+template <typename T>
+static void RunBenchmarks(
+    std::string_view const type,
+    CLinqBenchmarkOptions const& options,
+    CLinqBenchmarkReporter const& reporter)
+{
+    if (!options.IncludesType(type))
+    {
+        return;
+    }
+
+    auto const cases = MakeCases<T>();
+    auto const fullName = [&](CLinqBenchmarkCase<T> const& benchmark)
+    {
+        return std::string(benchmark.name) + "/" + std::string(type);
+    };
+
+    auto const anySelected = std::ranges::any_of(cases, [&](auto const& benchmark)
+    {
+        return options.Includes(fullName(benchmark));
+    });
+
+    if (!anySelected)
+    {
+        return;
+    }
+
+    for (std::size_t size = 100; size <= options.maximumSize; size *= 10)
+    {
+        if (size < options.minimumSize)
+        {
+            continue;
+        }
+
+        auto const input = CLinqBenchmarkInput<T>(size);
+
+        for (auto const& benchmark : cases)
+        {
+            if (!options.Includes(fullName(benchmark)))
+            {
+                continue;
+            }
+
+            auto const clinq = CLinqBenchmarkMeasure([&] { benchmark.clinq(input); }, size, options.minimumTime);
+
+            if (options.compare && benchmark.baseline)
+            {
+                auto const baseline = CLinqBenchmarkMeasure([&] { benchmark.baseline(input); }, size, options.minimumTime);
+                reporter.Report(benchmark.name, type, size, clinq, &baseline);
+            }
+            else
+            {
+                reporter.Report(benchmark.name, type, size, clinq, nullptr);
+            }
+        }
+    }
+}
+
+int main(int const argc, char const* const* const argv)
+{
+    auto options = CLinqBenchmarkOptions();
+
+    try
+    {
+        options = CLinqBenchmarkOptions::Parse(argc, argv);
+    }
+    catch (std::exception const& exception)
+    {
+        std::fprintf(stderr, "%s\n", exception.what());
+        CLinqBenchmarkOptions::PrintUsage();
+        return 1;
+    }
+
+    if (options.help)
+    {
+        CLinqBenchmarkOptions::PrintUsage();
+        return 0;
+    }
+
+    auto const reporter = CLinqBenchmarkReporter(options);
+
+    RunBenchmarks<int>("int", options, reporter);
+    RunBenchmarks<double>("double", options, reporter);
+    RunBenchmarks<std::string>("string", options, reporter);
+    RunBenchmarks<CLinqBenchmarkPayload>("payload", options, reporter);
+
+    return 0;
+}
@@ -2,6 +2,13 @@
 /// Defines the CLinq module interface.
 
 module;
+// min and max macros, such as those defined by windows.h without NOMINMAX, are suspended until
+// the end of this module so that they cannot break calls to std::min and std::max.
+#pragma push_macro("min")
+#pragma push_macro("max")
+#undef min
+#undef max
+
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -16,6 +23,63 @@ module;
 #include <map>
 #include <unordered_map>
 #include <type_traits>
+#include <iterator>
+#include <optional>
+#include <memory>
+#include <numeric>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <array>
+#include <bit>
+#include <utility>
+#include <system_error>
+#include <cerrno>
+#include <cstring>
+#include <istream>
+#include <fstream>
+#include <coroutine>
+#include <ranges>
+#include <tuple>
+
+#if defined(_WIN32)
+// windows.h is only needed to memory map files. It is included lean and without its min and max
+// macros, and WIN32_LEAN_AND_MEAN and NOMINMAX are restored afterwards so they do not leak into
+// the including code. Code needing the parts of windows.h which WIN32_LEAN_AND_MEAN excludes
+// should include it before this header.
+#pragma push_macro("WIN32_LEAN_AND_MEAN")
+#pragma push_macro("NOMINMAX")
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#pragma pop_macro("NOMINMAX")
+#pragma pop_macro("WIN32_LEAN_AND_MEAN")
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__AVX2__)
+#define CLINQ_SIMD_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CLINQ_SIMD_SSE2
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define CLINQ_SIMD_NEON
+#include <arm_neon.h>
+#endif
 export module CLinq;
 
 /// Checks if the given type is iterable. By default, this will be false.
@@ -33,6 +97,35 @@ struct IsCLinqIterable<T, std::void_t<decltype(std::begin(std::declval<T>())), d
 export template <typename T>
 concept CLinqIterable = IsCLinqIterable<T>::value;
 
+/// Concept for checking if a type is a CLinq enumerator.
+/// An enumerator is advanced with MoveNext and the element it is positioned on is read with Current.
+/// @tparam T The type to check.
+export template <typename T>
+concept CLinqEnumerator = requires(T enumerator)
+{
+    typename T::value_type;
+    { enumerator.MoveNext() } -> std::convertible_to<bool>;
+    enumerator.Current();
+};
+
+export template <CLinqEnumerator TEnumerator>
+class CLinqQuery;
+
+export template <typename TIterator>
+class CLinqIteratorEnumerator;
+
+export template <typename TElement>
+class CLinqView;
+
+export template <typename TElement>
+class CLinqParallelCollection;
+
+export template <typename TElement, typename TAllocator>
+class CLinqOrderedCollection;
+
+export template <typename TKey, typename TElement, typename TAllocator>
+class CLinqLookup;
+
 /// Thrown when an error occurs in the CLinq library.
 export class CLinqException final : public std::runtime_error
 {
@@ -58,641 +151,7385 @@ export class CLinqException final : public std::runtime_error
         }
 };
 
-/// A collection of elements supporting CLinq methods.
-/// @tparam TElement The type of elements in the collection.
-export template <typename TElement>
-class CLinqCollection
+/// Concept for checking if a collection selector projects an element to a range which SelectMany can flatten.
+/// @tparam TCollectionSelector The type of the collection selector.
+/// @tparam TElement The type of the element it is invoked with.
+export template <typename TCollectionSelector, typename TElement>
+concept CLinqCollectionSelector = std::invocable<TCollectionSelector&, TElement> &&
+    std::ranges::input_range<std::invoke_result_t<TCollectionSelector&, TElement>>;
+
+/// Concept for checking if a type can be hashed with std::hash.
+/// @tparam T The type to check.
+export template <typename T>
+concept CLinqHashable = requires(T const& value)
 {
-    public:
-        using value_type = TElement;
-        using size_type = std::vector<TElement>::size_type;
+    { std::hash<T>{}(value) } -> std::convertible_to<std::size_t>;
+};
 
-        using iterator = std::vector<TElement>::iterator;
-        using const_iterator = std::vector<TElement>::const_iterator;
-        using reverse_iterator = std::vector<TElement>::reverse_iterator;
+/// Function object returning the lesser of two values, preferring the first when they are equal.
+export struct CLinqMinimum
+{
+    /// Gets the lesser of two values.
+    /// @param left The first value.
+    /// @param right The second value.
+    /// @returns The lesser of the two values.
+    template <typename T>
+    constexpr T const& operator()(T const& left, T const& right) const
+    {
+        return right < left ? right : left;
+    }
+};
 
-        /// Type alias for a function that maps elements to true or false.
-        using MatchFunction = std::function<bool(TElement)>;
+/// Function object returning the greater of two values, preferring the first when they are equal.
+export struct CLinqMaximum
+{
+    /// Gets the greater of two values.
+    /// @param left The first value.
+    /// @param right The second value.
+    /// @returns The greater of the two values.
+    template <typename T>
+    constexpr T const& operator()(T const& left, T const& right) const
+    {
+        return left < right ? right : left;
+    }
+};
 
-        /// Type alias for a function that projects elements to some other type.
-        /// @tparam TProjection The type to project the elements to.
-        template <typename TProjection>
-        using ProjectionFunction = std::function<TProjection(TElement)>;
+/// Result selector for SelectMany which selects each inner element, ignoring the outer element.
+export struct CLinqSelectInner
+{
+    /// Gets the inner element.
+    /// @param inner The inner element.
+    /// @returns The inner element.
+    template <typename TOuter, typename TInner>
+    constexpr TInner&& operator()(TOuter const&, TInner&& inner) const noexcept
+    {
+        return std::forward<TInner>(inner);
+    }
+};
 
-        /// Initializes a new instance of the CLinqCollection class.
-        CLinqCollection() noexcept
-            : _elements(std::vector<TElement>())
-        {
-        }
+/// Describes how elements of a type are packed into SIMD registers on the target instruction set.
+/// Specializations provide Load, Store, Broadcast, BroadcastLast, an Apply overload for each vectorised
+/// operation and PrefixSum, which computes the running sums of the lanes of a register. Wide lanes may
+/// also Load narrower elements, widening each to fill a register, so that they can be reduced without
+/// overflow or loss of precision.
+/// @tparam T The element type.
+export template <typename T>
+struct CLinqSimdLanes
+{
+    static constexpr bool IsVectorised = false;
+};
 
-        /// Initializes a new instance of the CLinqCollection class.
-        CLinqCollection(std::initializer_list<TElement> const& elements) noexcept
-            : _elements(std::vector<TElement>(elements.begin(), elements.end()))
-        {
-        }
+#if defined(CLINQ_SIMD_AVX2)
+template <>
+struct CLinqSimdLanes<float>
+{
+    using Vector = __m256;
+    static constexpr bool IsVectorised = true;
+    static constexpr std::size_t Width = 8;
 
-        /// Initializes a new instance of the CLinqCollection class.
-        /// @param elements The initial elements.
-        CLinqCollection(std::vector<TElement> const& elements) noexcept
-            : _elements(elements)
-        {
-        }
+    static Vector Load(float const* const data) noexcept { return _mm256_loadu_ps(data); }
+    static void Store(float* const data, Vector const vector) noexcept { _mm256_storeu_ps(data, vector); }
+    static Vector Broadcast(float const value) noexcept { return _mm256_set1_ps(value); }
+    static Vector BroadcastLast(Vector const vector) noexcept { return _mm256_permutevar8x32_ps(vector, _mm256_set1_epi32(7)); }
+    static Vector Apply(std::plus<>, Vector const left, Vector const right) noexcept { return _mm256_add_ps(left, right); }
+    static Vector Apply(std::multiplies<>, Vector const left, Vector const right) noexcept { return _mm256_mul_ps(left, right); }
+    static Vector Apply(CLinqMinimum, Vector const left, Vector const right) noexcept { return _mm256_min_ps(left, right); }
+    static Vector Apply(CLinqMaximum, Vector const left, Vector const right) noexcept { return _mm256_max_ps(left, right); }
+    static Vector PrefixSum(Vector vector) noexcept
+    {
+        vector = _mm256_add_ps(vector, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(vector), 4)));
+        vector = _mm256_add_ps(vector, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(vector), 8)));
+        auto const low = _mm256_permute_ps(vector, _MM_SHUFFLE(3, 3, 3, 3));
+        return _mm256_add_ps(vector, _mm256_permute2f128_ps(low, low, 0x08));
+    }
+};
 
-        /// Initializes a new instance of the CLinqCollection class.
-        /// @param memory A block of memory to copy values from.
-        /// @param numberOfElements The number of elements to copy.
-        explicit CLinqCollection(TElement* const memory, size_type const numberOfElements) noexcept
-            : _elements(std::vector<TElement>(memory, memory + numberOfElements))
-        {
-        }
+template <>
+struct CLinqSimdLanes<double>
+{
+    using Vector = __m256d;
+    static constexpr bool IsVectorised = true;
+    static constexpr std::size_t Width = 4;
 
-        /// Initializes a new instance of the CLinqCollection class.
-        /// @tparam TIterable An iterable type.
-        /// @param iterable The iterable instance.
-        template <CLinqIterable TIterable>
-        explicit CLinqCollection(TIterable& iterable)
-            : _elements(std::vector<TElement>())
-        {
-            for (auto& element : iterable)
-            {
-                _elements.emplace_back(element);
-            }
-        }
+    static Vector Load(double const* const data) noexcept { return _mm256_loadu_pd(data); }
+    static Vector Load(float const* const data) noexcept { return _mm256_cvtps_pd(_mm_loadu_ps(data)); }
+    static void Store(double* const data, Vector const vector) noexcept { _mm256_storeu_pd(data, vector); }
+    static Vector Broadcast(double const value) noexcept { return _mm256_set1_pd(value); }
+    static Vector BroadcastLast(Vector const vector) noexcept { return _mm256_permute4x64_pd(vector, 0xFF); }
+    static Vector Apply(std::plus<>, Vector const left, Vector const right) noexcept { return _mm256_add_pd(left, right); }
+    static Vector Apply(std::multiplies<>, Vector const left, Vector const right) noexcept { return _mm256_mul_pd(left, right); }
+    static Vector Apply(CLinqMinimum, Vector const left, Vector const right) noexcept { return _mm256_min_pd(left, right); }
+    static Vector Apply(CLinqMaximum, Vector const left, Vector const right) noexcept { return _mm256_max_pd(left, right); }
+    static Vector PrefixSum(Vector vector) noexcept
+    {
+        vector = _mm256_add_pd(vector, _mm256_castsi256_pd(_mm256_slli_si256(_mm256_castpd_si256(vector), 8)));
+        auto const low = _mm256_permute_pd(vector, 0xF);
+        return _mm256_add_pd(vector, _mm256_permute2f128_pd(low, low, 0x08));
+    }
+};
 
-        /// Gets a reference to the element at a given index of the collection.
-        /// @param i The index.
-        /// @returns A reference to the element at a given index of the collection.
-        TElement& operator[](size_type const i)
-        {
-            return _elements[i];
-        }
+template <>
+struct CLinqSimdLanes<std::int32_t>
+{
+    using Vector = __m256i;
+    static constexpr bool IsVectorised = true;
+    static constexpr std::size_t Width = 8;
 
-        /// Gets a const reference to the element at a given index of the collection.
-        /// @param i The index.
-        /// @returns A const reference to the element at a given index of the collection.
-        TElement const& operator[](size_type const i) const
+    static Vector Load(std::int32_t const* const data) noexcept { return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data)); }
+    static void Store(std::int32_t* const data, Vector const vector) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), vector); }
+    static Vector Broadcast(std::int32_t const value) noexcept { return _mm256_set1_epi32(value); }
+    static Vector BroadcastLast(Vector const vector) noexcept { return _mm256_permutevar8x32_epi32(vector, _mm256_set1_epi32(7)); }
+    static Vector Apply(std::plus<>, Vector const left, Vector const right) noexcept { return _mm256_add_epi32(left, right); }
+    static Vector Apply(std::multiplies<>, Vector const left, Vector const right) noexcept { return _mm256_mullo_epi32(left, right); }
+    static Vector Apply(CLinqMinimum, Vector const left, Vector const right) noexcept { return _mm256_min_epi32(left, right); }
+    static Vector Apply(CLinqMaximum, Vector const left, Vector const right) noexcept { return _mm256_max_epi32(left, right); }
+    static Vector PrefixSum(Vector vector) noexcept
+    {
+        vector = _mm256_add_epi32(vector, _mm256_slli_si256(vector, 4));
+        vector = _mm256_add_epi32(vector, _mm256_slli_si256(vector, 8));
+        auto const low = _mm256_shuffle_epi32(vector, _MM_SHUFFLE(3, 3, 3, 3));
+        return _mm256_add_epi32(vector, _mm256_permute2x128_si256(low, low, 0x08));
+    }
+};
+
+template <>
+struct CLinqSimdLanes<std::int64_t>
+{
+    using Vector = __m256i;
+    static constexpr bool IsVectorised = true;
+    static constexpr std::size_t Width = 4;
+
+    static Vector Load(std::int64_t const* const data) noexcept { return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data)); }
+    static Vector Load(std::int32_t const* const data) noexcept { return _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<__m128i const*>(data))); }
+    static void Store(std::int64_t* const data, Vector const vector) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), vector); }
+    static Vector Broadcast(std::int64_t const value) noexcept { return _mm256_set1_epi64x(value); }
+    static Vector BroadcastLast(Vector const vector) noexcept { return _mm256_permute4x64_epi64(vector, 0xFF); }
+    static Vector Apply(std::plus<>, Vector const left, Vector const right) noexcept { return _mm256_add_epi64(left, right); }
+    static Vector PrefixSum(Vector vector) noexcept
+    {
+        vector = _mm256_add_epi64(vector, _mm256_slli_si256(vector, 8));
+        auto const low = _mm256_shuffle_epi32(vector, _MM_SHUFFLE(3, 2, 3, 2));
+        return _mm256_add_epi64(vector, _mm256_permute2x128_si256(low, low, 0x08));
+    }
+};
+#elif defined(CLINQ_SIMD_SSE2)
+template <>
+struct CLinqSimdLanes<float>
+{
+    using Vector = __m128;
+    static constexpr bool IsVectorised = true;
+    static constexpr std::size_t Width = 4;
+
+    static Vector Load(float const* const data) noexcept { return _mm_loadu_ps(data); }
+    static void Store(float* const data, Vector const vector) noexcept { _mm_storeu_ps(data, vector); }
+    static Vector Broadcast(float const value) noexcept { return _mm_set1_ps(value); }
+    static Vector BroadcastLast(Vector const vector) noexcept { return _mm_shuffle_ps(vector, vector, _MM_SHUFFLE(3, 3, 3, 3)); }
+    static Vector Apply(std::plus<>, Vector const left, Vector const right) noexcept { return _mm_add_ps(left, right); }
+    static Vector Apply(std::multiplies<>, Vector const left, Vector const right) noexcept { return _mm_mul_ps(left, right); }
+    static Vector Apply(CLinqMinimum, Vector const left, Vector const right) noexcept { return _mm_min_ps(left, right); }
+    static Vector Apply(CLinqMaximum, Vector const left, Vector const right) noexcept { return _mm_max_ps(left, right); }
+    static Vector PrefixSum(Vector vector) noexcept
+    {
+        vector = _mm_add_ps(vector, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(vector), 4)));
+        return _mm_add_ps(vector, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(vector), 8)));
+    }
+};
+
+template <>
+struct CLinqSimdLanes<double>
+{
+    using Vector = __m128d;
+    static constexpr bool IsVectorised = true;
+    static constexpr std::size_t Width = 2;
+
+    static Vector Load(double const* const data) noexcept { return _mm_loadu_pd(data); }
+    static Vector Load(float const* const data) noexcept { return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(data)))); }
+    static void Store(double* const data, Vector const vector) noexcept { _mm_storeu_pd(data, vector); }
+    static Vector Broadcast(double const value) noexcept { return _mm_set1_pd(value); }
+    static Vector BroadcastLast(Vector const vector) noexcept { return _mm_unpackhi_pd(vector, vector); }
+    static Vector Apply(std::plus<>, Vector const left, Vector const right) noexcept { return _mm_add_pd(left, right); }
+    static Vector Apply(std::multiplies<>, Vector const left, Vector const right) noexcept { return _mm_mul_pd(left, right); }
+    static Vector Apply(CLinqMinimum, Vector const left, Vector const right) noexcept { return _mm_min_pd(left, right); }
+    static Vector Apply(CLinqMaximum, Vector const left, Vector const right) noexcept { return _mm_max_pd(left, right); }
+    static Vector PrefixSum(Vector const vector) noexcept
+    {
+        return _mm_add_pd(vector, _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(vector), 8)));
+    }
+};
+
+template <>
+struct CLinqSimdLanes<std::int32_t>
+{
+    using Vector = __m128i;
+    static constexpr bool IsVectorised = true;
+    static constexpr std::size_t Width = 4;
+
+    static Vector Load(std::int32_t const* const data) noexcept { return _mm_loadu_si128(reinterpret_cast<__m128i const*>(data)); }
+    static void Store(std::int32_t* const data, Vector const vector) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i*>(data), vector); }
+    static Vector Broadcast(std::int32_t const value) noexcept { return _mm_set1_epi32(value); }
+    static Vector BroadcastLast(Vector const vector) noexcept { return _mm_shuffle_epi32(vector, _MM_SHUFFLE(3, 3, 3, 3)); }
+    static Vector Apply(std::plus<>, Vector const left, Vector const right) noexcept { return _mm_add_epi32(left, right); }
+    static Vector PrefixSum(Vector vector) noexcept
+    {
+        vector = _mm_add_epi32(vector, _mm_slli_si128(vector, 4));
+        return _mm_add_epi32(vector, _mm_slli_si128(vector, 8));
+    }
+#if defined(__SSE4_1__)
+    static Vector Apply(std::multiplies<>, Vector const left, Vector const right) noexcept { return _mm_mullo_epi32(left, right); }
+    static Vector Apply(CLinqMinimum, Vector const left, Vector const right) noexcept { return _mm_min_epi32(left, right); }
+    static Vector Apply(CLinqMaximum, Vector const left, Vector const right) noexcept { return _mm_max_epi32(left, right); }
+#endif
+};
+
+template <>
+struct CLinqSimdLanes<std::int64_t>
+{
+    using Vector = __m128i;
+    static constexpr bool IsVectorised = true;
+    static constexpr std::size_t Width = 2;
+
+    static Vector Load(std::int64_t const* const data) noexcept { return _mm_loadu_si128(reinterpret_cast<__m128i const*>(data)); }
+    static void Store(std::int64_t* const data, Vector const vector) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i*>(data), vector); }
+    static Vector Broadcast(std::int64_t const value) noexcept { return _mm_set1_epi64x(value); }
+    static Vector BroadcastLast(Vector const vector) noexcept { return _mm_shuffle_epi32(vector, _MM_SHUFFLE(3, 2, 3, 2)); }
+    static Vector Apply(std::plus<>, Vector const left, Vector const right) noexcept { return _mm_add_epi64(left, right); }
+    static Vector PrefixSum(Vector const vector) noexcept
+    {
+        return _mm_add_epi64(vector, _mm_slli_si128(vector, 8));
+    }
+#if defined(__SSE4_1__)
+    static Vector Load(std::int32_t const* const data) noexcept { return _mm_cvtepi32_epi64(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(data))); }
+#endif
+};
+#elif defined(CLINQ_SIMD_NEON)
+template <>
+struct CLinqSimdLanes<float>
+{
+    using Vector = float32x4_t;
+    static constexpr bool IsVectorised = true;
+    static constexpr std::size_t Width = 4;
+
+    static Vector Load(float const* const data) noexcept { return vld1q_f32(data); }
+    static void Store(float* const data, Vector const vector) noexcept { vst1q_f32(data, vector); }
+    static Vector Broadcast(float const value) noexcept { return vdupq_n_f32(value); }
+    static Vector BroadcastLast(Vector const vector) noexcept { return vdupq_n_f32(vgetq_lane_f32(vector, 3)); }
+    static Vector Apply(std::plus<>, Vector const left, Vector const right) noexcept { return vaddq_f32(left, right); }
+    static Vector Apply(std::multiplies<>, Vector const left, Vector const right) noexcept { return vmulq_f32(left, right); }
+    static Vector Apply(CLinqMinimum, Vector const left, Vector const right) noexcept { return vminq_f32(left, right); }
+    static Vector Apply(CLinqMaximum, Vector const left, Vector const right) noexcept { return vmaxq_f32(left, right); }
+    static Vector PrefixSum(Vector vector) noexcept
+    {
+        vector = vaddq_f32(vector, vextq_f32(vdupq_n_f32(0), vector, 3));
+        return vaddq_f32(vector, vextq_f32(vdupq_n_f32(0), vector, 2));
+    }
+};
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+template <>
+struct CLinqSimdLanes<double>
+{
+    using Vector = float64x2_t;
+    static constexpr bool IsVectorised = true;
+    static constexpr std::size_t Width = 2;
+
+    static Vector Load(double const* const data) noexcept { return vld1q_f64(data); }
+    static Vector Load(float const* const data) noexcept { return vcvt_f64_f32(vld1_f32(data)); }
+    static void Store(double* const data, Vector const vector) noexcept { vst1q_f64(data, vector); }
+    static Vector Broadcast(double const value) noexcept { return vdupq_n_f64(value); }
+    static Vector BroadcastLast(Vector const vector) noexcept { return vdupq_n_f64(vgetq_lane_f64(vector, 1)); }
+    static Vector Apply(std::plus<>, Vector const left, Vector const right) noexcept { return vaddq_f64(left, right); }
+    static Vector Apply(std::multiplies<>, Vector const left, Vector const right) noexcept { return vmulq_f64(left, right); }
+    static Vector Apply(CLinqMinimum, Vector const left, Vector const right) noexcept { return vminq_f64(left, right); }
+    static Vector Apply(CLinqMaximum, Vector const left, Vector const right) noexcept { return vmaxq_f64(left, right); }
+    static Vector PrefixSum(Vector const vector) noexcept
+    {
+        return vaddq_f64(vector, vextq_f64(vdupq_n_f64(0), vector, 1));
+    }
+};
+#endif
+
+template <>
+struct CLinqSimdLanes<std::int32_t>
+{
+    using Vector = int32x4_t;
+    static constexpr bool IsVectorised = true;
+    static constexpr std::size_t Width = 4;
+
+    static Vector Load(std::int32_t const* const data) noexcept { return vld1q_s32(data); }
+    static void Store(std::int32_t* const data, Vector const vector) noexcept { vst1q_s32(data, vector); }
+    static Vector Broadcast(std::int32_t const value) noexcept { return vdupq_n_s32(value); }
+    static Vector BroadcastLast(Vector const vector) noexcept { return vdupq_n_s32(vgetq_lane_s32(vector, 3)); }
+    static Vector Apply(std::plus<>, Vector const left, Vector const right) noexcept { return vaddq_s32(left, right); }
+    static Vector Apply(std::multiplies<>, Vector const left, Vector const right) noexcept { return vmulq_s32(left, right); }
+    static Vector Apply(CLinqMinimum, Vector const left, Vector const right) noexcept { return vminq_s32(left, right); }
+    static Vector Apply(CLinqMaximum, Vector const left, Vector const right) noexcept { return vmaxq_s32(left, right); }
+    static Vector PrefixSum(Vector vector) noexcept
+    {
+        vector = vaddq_s32(vector, vextq_s32(vdupq_n_s32(0), vector, 3));
+        return vaddq_s32(vector, vextq_s32(vdupq_n_s32(0), vector, 2));
+    }
+};
+
+template <>
+struct CLinqSimdLanes<std::int64_t>
+{
+    using Vector = int64x2_t;
+    static constexpr bool IsVectorised = true;
+    static constexpr std::size_t Width = 2;
+
+    static Vector Load(std::int64_t const* const data) noexcept { return vld1q_s64(data); }
+    static Vector Load(std::int32_t const* const data) noexcept { return vmovl_s32(vld1_s32(data)); }
+    static void Store(std::int64_t* const data, Vector const vector) noexcept { vst1q_s64(data, vector); }
+    static Vector Broadcast(std::int64_t const value) noexcept { return vdupq_n_s64(value); }
+    static Vector BroadcastLast(Vector const vector) noexcept { return vdupq_n_s64(vgetq_lane_s64(vector, 1)); }
+    static Vector Apply(std::plus<>, Vector const left, Vector const right) noexcept { return vaddq_s64(left, right); }
+    static Vector PrefixSum(Vector const vector) noexcept
+    {
+        return vaddq_s64(vector, vextq_s64(vdupq_n_s64(0), vector, 1));
+    }
+};
+#endif
+
+/// Kernels over contiguous elements which use SIMD registers for the element types and operations
+/// described by CLinqSimdLanes on the target instruction set (AVX2, SSE2/SSE4.1 or NEON), and scalar
+/// loops otherwise. The instruction set is selected when the translation unit is compiled.
+export class CLinqSimd final
+{
+    public:
+        using size_type = std::size_t;
+
+        /// Checks whether or not an operation on elements of a type has a vectorised kernel.
+        /// @tparam T The element type.
+        /// @tparam TOperation The type of the operation.
+        template <typename T, typename TOperation>
+        static constexpr bool IsVectorised = requires(typename CLinqSimdLanes<T>::Vector vector)
         {
-            return _elements[i];
-        }
+            CLinqSimdLanes<T>::Apply(TOperation{}, vector, vector);
+        };
 
-        /// Spaceship operator.
-        /// @param collection The collection to compare to.
-        /// @returns An ordering comparing this instance and the given collection.
-        auto operator<=>(CLinqCollection<TElement> const&) const = default;
+        /// Checks whether or not scanning elements of a type with an operation has a vectorised kernel.
+        /// Only sums are scanned in registers.
+        /// @tparam T The element type.
+        /// @tparam TOperation The type of the operation.
+        template <typename T, typename TOperation>
+        static constexpr bool IsScanVectorised = std::is_same_v<TOperation, std::plus<>> &&
+            requires(typename CLinqSimdLanes<T>::Vector vector)
+            {
+                CLinqSimdLanes<T>::PrefixSum(vector);
+            };
 
-        /// Concatenates this collection with the given collection and returns the result.
-        /// @param collection The collection.
-        /// @returns This instance concatenated with the given collection.
-        CLinqCollection<TElement> operator+(CLinqCollection<TElement> const& collection) const noexcept
+        /// Checks whether or not reducing elements of a type in a result type has a vectorised kernel, which
+        /// requires the lanes of the result type to load the elements.
+        /// @tparam TResult The type the elements are reduced in.
+        /// @tparam T The element type.
+        /// @tparam TOperation The type of the operation.
+        template <typename TResult, typename T, typename TOperation>
+        static constexpr bool IsReduceVectorised = IsVectorised<TResult, TOperation> &&
+            requires(T const* const data)
+            {
+                CLinqSimdLanes<TResult>::Load(data);
+            };
+
+        /// Reduces a non-empty range of elements with an associative operation.
+        /// Vectorised reductions combine elements in a different order to a sequential fold,
+        /// so floating point sums may differ in rounding and NaN handling is unspecified.
+        /// @tparam TResult The type the elements are converted to and reduced in, which defaults to the element
+        /// type. Summing narrow integers in std::int64_t or floats in double avoids overflow and loss of precision.
+        /// @tparam T The element type.
+        /// @tparam TOperation The type of the operation.
+        /// @param data A pointer to the first element.
+        /// @param numberOfElements The number of elements, which must be at least 1.
+        /// @param operation The operation.
+        /// @returns The elements reduced with the operation.
+        template <typename TResult = void, typename T, typename TOperation>
+        static auto Reduce(T const* const data, size_type const numberOfElements, TOperation const operation)
         {
-            auto newSize = _elements.size() + collection._elements.size();
-            auto newElements = std::vector<TElement>(newSize);
+            using TReduce = std::conditional_t<std::is_void_v<TResult>, T, TResult>;
 
-            for (auto i = 0; i < _elements.size(); ++i)
+            size_type i = 1;
+            auto result = static_cast<TReduce>(data[0]);
+
+            if constexpr (IsReduceVectorised<TReduce, T, TOperation>)
             {
-                newElements[i] = _elements[i];
+                using TLanes = CLinqSimdLanes<TReduce>;
+                constexpr auto width = TLanes::Width;
+
+                if (numberOfElements >= width * 4)
+                {
+                    auto accumulator0 = TLanes::Load(data);
+                    auto accumulator1 = TLanes::Load(data + width);
+                    auto accumulator2 = TLanes::Load(data + width * 2);
+                    auto accumulator3 = TLanes::Load(data + width * 3);
+
+                    for (i = width * 4; i + width * 4 <= numberOfElements; i += width * 4)
+                    {
+                        accumulator0 = TLanes::Apply(operation, accumulator0, TLanes::Load(data + i));
+                        accumulator1 = TLanes::Apply(operation, accumulator1, TLanes::Load(data + i + width));
+                        accumulator2 = TLanes::Apply(operation, accumulator2, TLanes::Load(data + i + width * 2));
+                        accumulator3 = TLanes::Apply(operation, accumulator3, TLanes::Load(data + i + width * 3));
+                    }
+
+                    accumulator0 = TLanes::Apply(
+                        operation,
+                        TLanes::Apply(operation, accumulator0, accumulator1),
+                        TLanes::Apply(operation, accumulator2, accumulator3));
+
+                    TReduce lanes[width];
+                    TLanes::Store(lanes, accumulator0);
+
+                    result = lanes[0];
+                    for (size_type lane = 1; lane < width; ++lane)
+                    {
+                        result = static_cast<TReduce>(operation(result, lanes[lane]));
+                    }
+                }
             }
 
-            size_type index = 0;
-            for (auto i = _elements.size(); i < newSize; ++i)
+            for (; i < numberOfElements; ++i)
             {
-                newElements[i] = collection._elements[index];
-                ++index;
+                result = static_cast<TReduce>(operation(result, static_cast<TReduce>(data[i])));
             }
 
-            return CLinqCollection<TElement>(newElements);
+            return result;
         }
 
-        /// Gets an empty collection.
-        /// @return An empty collection.
-        static CLinqCollection<TElement> Empty()
+        /// Applies an operation to each pair of elements at the same index in two ranges.
+        /// Vectorised minimum and maximum of floating point elements may differ from CLinqMinimum and
+        /// CLinqMaximum when either element is NaN.
+        /// @tparam T The element type.
+        /// @tparam TOperation The type of the operation.
+        /// @param left A pointer to the first element of the left range.
+        /// @param right A pointer to the first element of the right range.
+        /// @param result A pointer to the first element of the result, which may alias either range.
+        /// @param numberOfElements The number of elements in each range.
+        /// @param operation The operation.
+        template <typename T, typename TOperation>
+        static void Transform(
+            T const* const left,
+            T const* const right,
+            T* const result,
+            size_type const numberOfElements,
+            TOperation const operation)
         {
-            return CLinqCollection<TElement>();
-        }
+            size_type i = 0;
 
-        /// Gets a collection containing the same element n times.
-        /// @param element The element.
-        /// @param count The number of elements.
-        /// @returns A collection containing the same element n times.
-        static CLinqCollection<TElement> Repeat(TElement const& element, size_type const count)
-        {
-            return CLinqCollection<TElement>(std::vector<TElement>(count, element));
-        }
+            if constexpr (IsVectorised<T, TOperation>)
+            {
+                using TLanes = CLinqSimdLanes<T>;
+                constexpr auto width = TLanes::Width;
 
-        /// Gets a collection starting from the initial element and prefix incrementing it n times.
-        /// @param initial The initial element.
-        /// @param count The number of elements.
-        /// @returns A collection starting from the initial element and prefix incrementing it n times.
-        static CLinqCollection<TElement> Range(TElement const& initial, size_type const count)
-        {
-            auto element = initial;
-            auto elements = std::vector<TElement>(count);
+                for (; i + width * 2 <= numberOfElements; i += width * 2)
+                {
+                    auto const result0 = TLanes::Apply(operation, TLanes::Load(left + i), TLanes::Load(right + i));
+                    auto const result1 = TLanes::Apply(operation, TLanes::Load(left + i + width), TLanes::Load(right + i + width));
+                    TLanes::Store(result + i, result0);
+                    TLanes::Store(result + i + width, result1);
+                }
 
-            for (size_type i = 0; i < count; ++i)
-            {
-                elements[i] = element;
-                ++element;
+                for (; i + width <= numberOfElements; i += width)
+                {
+                    TLanes::Store(result + i, TLanes::Apply(operation, TLanes::Load(left + i), TLanes::Load(right + i)));
+                }
             }
 
-            return CLinqCollection<TElement>(elements);
+            for (; i < numberOfElements; ++i)
+            {
+                result[i] = static_cast<T>(operation(left[i], right[i]));
+            }
         }
 
-        /// Gets the iterator at the start of the collection.
-        iterator begin() noexcept
+        /// Computes the running results of an operation over a range of elements, starting from a seed, so
+        /// that each result is the operation applied to the previous result and the element at its index.
+        /// Vectorised sums add the elements of a register to each other before adding the previous result,
+        /// so floating point sums may differ in rounding from a sequential scan.
+        /// @tparam T The element type.
+        /// @tparam TOperation The type of the operation.
+        /// @param data A pointer to the first element.
+        /// @param result A pointer to the first result, which may alias the elements.
+        /// @param numberOfElements The number of elements.
+        /// @param seed The value preceding the first result.
+        /// @param operation The operation.
+        template <typename T, typename TOperation>
+        static void InclusiveScan(
+            T const* const data,
+            T* const result,
+            size_type const numberOfElements,
+            T seed,
+            TOperation const operation)
         {
-            return _elements.begin();
-        }
+            size_type i = 0;
 
-        /// Gets the iterator at the end of the collection.
-        iterator end() noexcept
-        {
-            return _elements.end();
-        }
+            if constexpr (IsScanVectorised<T, TOperation>)
+            {
+                using TLanes = CLinqSimdLanes<T>;
+                constexpr auto width = TLanes::Width;
 
-        /// Gets the const iterator at the start of the collection.
-        const_iterator cbegin() const noexcept
-        {
-            return _elements.cbegin();
-        }
+                auto previous = TLanes::Broadcast(seed);
 
-        /// Gets the const iterator at the end of the collection.
-        const_iterator cend() const noexcept
-        {
-            return _elements.cend();
-        }
+                for (; i + width <= numberOfElements; i += width)
+                {
+                    auto const sums = TLanes::Apply(operation, previous, TLanes::PrefixSum(TLanes::Load(data + i)));
+                    TLanes::Store(result + i, sums);
+                    previous = TLanes::BroadcastLast(sums);
+                }
 
-        /// Checks that every element in the collection matches the given match function.
-        /// @param matchFunction The match function.
-        /// @returns True if every element in the collection matches the given match
-        /// function, false otherwise.
-        bool All(MatchFunction const& matchFunction) const noexcept
-        {
-            for (auto& element : _elements)
-            {
-                if (!matchFunction(element))
+                if (i != 0)
                 {
-                    return false;
+                    seed = result[i - 1];
                 }
             }
 
-            return true;
+            for (; i < numberOfElements; ++i)
+            {
+                seed = static_cast<T>(operation(seed, data[i]));
+                result[i] = seed;
+            }
         }
+};
 
-        /// Checks if the collection contains any element.
-        /// @returns True if the collection contains any element, false otherwise.
-        bool Any() const noexcept
-        {
-            return !_elements.empty();
-        }
+/// Stable sorting of a sequence by keys which are extracted exactly once per element.
+/// Arithmetic and enumeration keys are mapped to unsigned integers which preserve their order and
+/// sorted with an LSD radix sort, skipping any byte which is the same for every key. Other keys
+/// are sorted with a stable comparison sort of their indices.
+export class CLinqSort final
+{
+    public:
+        /// Whether keys of a given type are sorted with a radix sort.
+        /// @tparam TKey The type of key.
+        template <typename TKey>
+        static constexpr bool IsRadixSortable =
+            (std::is_arithmetic_v<TKey> || std::is_enum_v<TKey>) &&
+            !std::is_same_v<TKey, long double> &&
+            sizeof(TKey) <= sizeof(std::uint64_t);
 
-        /// Checks if the collection contains any element that matches the
-        /// given function.
-        /// @param matchFunction The match function.
-        /// @returns True if the collection contains any element that matches
-        /// the given function, false otherwise.
-        bool Any(MatchFunction const& matchFunction) const noexcept
+        /// Stably sorts a sequence by key.
+        /// Every key is extracted before the first element is emitted, so elements may be moved
+        /// from as they are emitted.
+        /// @tparam TKeyOf The type of the function getting the key of an element.
+        /// @tparam TEmit The type of the function receiving the elements in sorted order.
+        /// @tparam TAllocator The type of allocator for temporary storage.
+        /// @param count The number of elements.
+        /// @param keyOf Gets the key of the element at an index. Called exactly once per element.
+        /// @param descending Whether to sort by descending rather than ascending key.
+        /// @param emit Called with the index of each element in sorted order, and whether its key
+        /// is equal to the key of the element emitted before it.
+        /// @param allocator The allocator for temporary storage.
+        template <typename TKeyOf, typename TEmit, typename TAllocator = std::allocator<std::byte>>
+        static void Sort(
+            std::size_t const count,
+            TKeyOf&& keyOf,
+            bool const descending,
+            TEmit&& emit,
+            TAllocator const& allocator = TAllocator())
         {
-            for (auto& element : _elements)
+            if (count <= std::numeric_limits<std::uint32_t>::max())
             {
-                if (matchFunction(element))
-                {
-                    return true;
-                }
+                SortCore<std::uint32_t>(count, keyOf, descending, emit, allocator);
+            }
+            else
+            {
+                SortCore<std::size_t>(count, keyOf, descending, emit, allocator);
             }
-
-            return false;
         }
 
-        /// Appends the element to the collection.
-        /// @param element The element.
-        /// @returns A new collection with the element appended.
-        CLinqCollection<TElement> Append(TElement const& element) const
+    private:
+        static constexpr std::size_t RadixThreshold = 1024;
+        static constexpr std::size_t RadixBuckets = 256;
+
+        template <typename T, typename TAllocator>
+        using Buffer = std::vector<T, typename std::allocator_traits<TAllocator>::template rebind_alloc<T>>;
+
+        template <std::size_t Size>
+        using UnsignedOfSize = std::conditional_t<Size == 1, std::uint8_t,
+            std::conditional_t<Size == 2, std::uint16_t,
+            std::conditional_t<Size == 4, std::uint32_t, std::uint64_t>>>;
+
+        template <typename T, typename TAllocator>
+        static Buffer<T, TAllocator> MakeBuffer(std::size_t const count, TAllocator const& allocator)
         {
-            auto newElements = _elements;
-            newElements.emplace_back(element);
+            using TBufferAllocator = typename std::allocator_traits<TAllocator>::template rebind_alloc<T>;
 
-            return CLinqCollection<TElement>(newElements);
+            return Buffer<T, TAllocator>(count, TBufferAllocator(allocator));
         }
 
-        /// Gets a const reference to the element at given index in the collection.
-        /// @param index The index.
-        /// @returns A const reference to the element at given index in the collection.
-        /// @throws CLinqException When the index is out of range.
-        TElement const& At(size_type const index) const
+        /// Maps a key to an unsigned integer such that comparing the integers compares the keys.
+        template <typename TKey>
+        static auto ToOrderedBits(TKey const key) noexcept
         {
-            ThrowIfEmpty();
-            ThrowIfOutOfRange(index);
+            if constexpr (std::is_enum_v<TKey>)
+            {
+                return ToOrderedBits(static_cast<std::underlying_type_t<TKey>>(key));
+            }
+            else if constexpr (std::is_same_v<TKey, bool>)
+            {
+                return static_cast<std::uint8_t>(key);
+            }
+            else if constexpr (std::is_floating_point_v<TKey>)
+            {
+                using TBits = UnsignedOfSize<sizeof(TKey)>;
+                constexpr auto sign = static_cast<TBits>(TBits(1) << (sizeof(TBits) * 8 - 1));
 
-            return _elements[index];
+                // Negative floats are ordered in reverse by their bits, so they are inverted. Zero is
+                // normalised so that -0.0 and 0.0 are equal, as they are when compared.
+                auto const bits = std::bit_cast<TBits>(key == TKey(0) ? TKey(0) : key);
+
+                return static_cast<TBits>((bits & sign) != 0 ? ~bits : bits | sign);
+            }
+            else
+            {
+                using TBits = std::make_unsigned_t<TKey>;
+                constexpr auto sign = static_cast<TBits>(TBits(1) << (sizeof(TBits) * 8 - 1));
+
+                return std::is_signed_v<TKey> ? static_cast<TBits>(static_cast<TBits>(key) ^ sign) : static_cast<TBits>(key);
+            }
         }
 
-        /// Concatenates the two collections and returns the result as a new instance.
-        /// @param collection The collection.
-        /// @returns The two collections concatenated.
-        CLinqCollection<TElement> Concat(CLinqCollection<TElement> collection) const
+        /// The type a key is compared as: its ordered bits if it is radix sortable, otherwise itself.
+        template <typename TKey, bool = IsRadixSortable<TKey>>
+        struct OrderedKeyOf
+        {
+            using type = TKey;
+        };
+
+        template <typename TKey>
+        struct OrderedKeyOf<TKey, true>
+        {
+            using type = decltype(ToOrderedBits(std::declval<TKey>()));
+        };
+
+        template <typename TIndex, typename TKeyOf, typename TEmit, typename TAllocator>
+        static void SortCore(
+            std::size_t const count,
+            TKeyOf& keyOf,
+            bool const descending,
+            TEmit& emit,
+            TAllocator const& allocator)
+        {
+            using TKey = std::remove_cvref_t<std::invoke_result_t<TKeyOf&, std::size_t>>;
+
+            auto indices = MakeBuffer<TIndex>(count, allocator);
+            std::iota(indices.begin(), indices.end(), TIndex(0));
+
+            if constexpr (IsRadixSortable<TKey>)
+            {
+                using TBits = decltype(ToOrderedBits(std::declval<TKey>()));
+
+                auto keys = MakeBuffer<TBits>(count, allocator);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    auto const bits = ToOrderedBits(static_cast<TKey>(std::invoke(keyOf, i)));
+                    keys[i] = descending ? static_cast<TBits>(~bits) : bits;
+                }
+
+                if (!RadixSort(keys, indices, allocator))
+                {
+                    std::stable_sort(indices.begin(), indices.end(), [&keys](TIndex const left, TIndex const right)
+                    {
+                        return keys[left] < keys[right];
+                    });
+
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        emit(static_cast<std::size_t>(indices[i]), i > 0 && keys[indices[i]] == keys[indices[i - 1]]);
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        emit(static_cast<std::size_t>(indices[i]), i > 0 && keys[i] == keys[i - 1]);
+                    }
+                }
+            }
+            else
+            {
+                auto keys = Buffer<TKey, TAllocator>(typename Buffer<TKey, TAllocator>::allocator_type(allocator));
+                keys.reserve(count);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    keys.emplace_back(std::invoke(keyOf, i));
+                }
+
+                auto const precedes = [&keys, descending](TIndex const left, TIndex const right)
+                {
+                    return descending ? keys[right] < keys[left] : keys[left] < keys[right];
+                };
+
+                std::stable_sort(indices.begin(), indices.end(), precedes);
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    emit(static_cast<std::size_t>(indices[i]), i > 0 && !precedes(indices[i - 1], indices[i]));
+                }
+            }
+        }
+
+        /// Sorts keys and their indices with a least significant digit radix sort, if it is likely
+        /// to be faster than a comparison sort.
+        /// @returns True if the keys were sorted.
+        template <typename TBits, typename TIndex, typename TAllocator>
+        static bool RadixSort(Buffer<TBits, TAllocator>& keys, Buffer<TIndex, TAllocator>& indices, TAllocator const& allocator)
+        {
+            constexpr auto digitCount = sizeof(TBits);
+            auto const count = keys.size();
+
+            if (count < RadixThreshold)
+            {
+                return false;
+            }
+
+            // A digit only needs a pass if it differs between keys, which is found by comparing
+            // the bits set in every key with the bits set in any key.
+            auto allBits = static_cast<TBits>(~TBits(0));
+            auto anyBits = TBits(0);
+            for (auto const key : keys)
+            {
+                allBits &= key;
+                anyBits |= key;
+            }
+
+            auto const varyingBits = static_cast<TBits>(allBits ^ anyBits);
+            auto digits = std::array<std::size_t, digitCount>{};
+            std::size_t passes = 0;
+            for (std::size_t digit = 0; digit < digitCount; ++digit)
+            {
+                if (((varyingBits >> (digit * 8)) & 0xFF) != 0)
+                {
+                    digits[passes++] = digit;
+                }
+            }
+
+            // Each pass scatters every key, so a comparison sort wins when many digits vary
+            // relative to the number of keys.
+            if (passes == 0 || passes * 4 >= static_cast<std::size_t>(std::bit_width(count)))
+            {
+                return passes == 0;
+            }
+
+            auto histograms = std::array<std::array<std::size_t, RadixBuckets>, digitCount>{};
+            for (auto const key : keys)
+            {
+                for (std::size_t pass = 0; pass < passes; ++pass)
+                {
+                    ++histograms[pass][(key >> (digits[pass] * 8)) & 0xFF];
+                }
+            }
+
+            auto scratchKeys = MakeBuffer<TBits>(count, allocator);
+            auto scratchIndices = MakeBuffer<TIndex>(count, allocator);
+
+            for (std::size_t pass = 0; pass < passes; ++pass)
+            {
+                auto& histogram = histograms[pass];
+                auto const shift = digits[pass] * 8;
+
+                std::size_t offset = 0;
+                for (auto& bucket : histogram)
+                {
+                    auto const bucketCount = bucket;
+                    bucket = offset;
+                    offset += bucketCount;
+                }
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    auto const position = histogram[(keys[i] >> shift) & 0xFF]++;
+                    scratchKeys[position] = keys[i];
+                    scratchIndices[position] = indices[i];
+                }
+
+                keys.swap(scratchKeys);
+                indices.swap(scratchIndices);
+            }
+
+            return true;
+        }
+
+    public:
+        /// Selects the values with the least keys from a sequence, keeping at most a given number
+        /// of them in a bounded heap. Values with equal keys are kept in the order they were offered,
+        /// so the selection is the same as a stable sort followed by a take.
+        /// @tparam TKey The type of key.
+        /// @tparam TValue The type of value.
+        /// @tparam TAllocator The type of allocator for the selected values.
+        template <typename TKey, typename TValue, typename TAllocator = std::allocator<TValue>>
+        class Selection final
+        {
+            public:
+                /// Initializes a new instance of the Selection class.
+                /// @param capacity The maximum number of values to select.
+                /// @param descending Whether to select the values with the greatest rather than the least keys.
+                /// @param allocator The allocator.
+                Selection(std::size_t const capacity, bool const descending, TAllocator const& allocator = TAllocator())
+                    : _capacity(capacity), _descending(descending), _offered(0), _entries(EntryAllocator(allocator))
+                {
+                }
+
+                /// Offers a value to the selection.
+                /// @tparam TMakeValue The type of the function making the value.
+                /// @param key The key of the value.
+                /// @param makeValue Makes the value. Only called if the value is selected when offered.
+                template <typename TMakeValue>
+                void Offer(TKey const& key, TMakeValue&& makeValue)
+                {
+                    auto const sequence = _offered++;
+
+                    if (_entries.size() < _capacity)
+                    {
+                        Push(Entry{ ToOrderedKey(key), sequence, std::invoke(makeValue) });
+
+                        return;
+                    }
+
+                    // The heap holds the selected value which sorts last at its front. A value offered
+                    // later sorts after any value with an equal key, so it must have a lesser key to replace it.
+                    // Most values are rejected here, so replacing is kept out of line, and keys which are not
+                    // radix sortable are compared in place so that they are only copied if the value is selected.
+                    if (_capacity == 0)
+                    {
+                        return;
+                    }
+
+                    if constexpr (IsRadixSortable<TKey>)
+                    {
+                        auto const orderedKey = ToOrderedKey(key);
+                        if (KeyPrecedes(orderedKey, _entries.front().key))
+                        {
+                            ReplaceLast(Entry{ orderedKey, sequence, std::invoke(makeValue) });
+                        }
+                    }
+                    else if (KeyPrecedes(key, _entries.front().key))
+                    {
+                        ReplaceLast(Entry{ key, sequence, std::invoke(makeValue) });
+                    }
+                }
+
+                /// Takes the selected values, sorted by key.
+                /// @returns The selected values.
+                std::vector<TValue, TAllocator> Values() &&
+                {
+                    std::sort_heap(_entries.begin(), _entries.end(), EntryPrecedes());
+
+                    auto values = std::vector<TValue, TAllocator>(TAllocator(_entries.get_allocator()));
+                    values.reserve(_entries.size());
+                    for (auto& entry : _entries)
+                    {
+                        values.emplace_back(std::move(entry.value));
+                    }
+
+                    return values;
+                }
+
+            private:
+                // Radix sortable keys are compared by their ordered bits, so that they are ordered
+                // exactly as CLinqSort::Sort orders them.
+                using OrderedKey = typename OrderedKeyOf<TKey>::type;
+
+                struct Entry
+                {
+                    OrderedKey key;
+                    std::size_t sequence;
+                    TValue value;
+                };
+
+                using EntryAllocator = typename std::allocator_traits<TAllocator>::template rebind_alloc<Entry>;
+
+                std::size_t _capacity;
+                bool _descending;
+                std::size_t _offered;
+                std::vector<Entry, EntryAllocator> _entries;
+
+                OrderedKey ToOrderedKey(TKey const& key) const
+                {
+                    if constexpr (IsRadixSortable<TKey>)
+                    {
+                        auto const bits = ToOrderedBits(key);
+
+                        return _descending ? static_cast<OrderedKey>(~bits) : bits;
+                    }
+                    else
+                    {
+                        return key;
+                    }
+                }
+
+                bool KeyPrecedes(OrderedKey const& left, OrderedKey const& right) const
+                {
+                    if constexpr (IsRadixSortable<TKey>)
+                    {
+                        return left < right;
+                    }
+                    else
+                    {
+                        return _descending ? right < left : left < right;
+                    }
+                }
+
+                auto EntryPrecedes() const
+                {
+                    return [this](Entry const& left, Entry const& right)
+                    {
+                        return KeyPrecedes(left.key, right.key) ||
+                            (!KeyPrecedes(right.key, left.key) && left.sequence < right.sequence);
+                    };
+                }
+
+                void Push(Entry&& entry)
+                {
+                    _entries.push_back(std::move(entry));
+                    std::push_heap(_entries.begin(), _entries.end(), EntryPrecedes());
+                }
+
+                void ReplaceLast(Entry&& entry)
+                {
+                    std::pop_heap(_entries.begin(), _entries.end(), EntryPrecedes());
+                    _entries.back() = std::move(entry);
+                    std::push_heap(_entries.begin(), _entries.end(), EntryPrecedes());
+                }
+        };
+};
+
+/// A monotonic arena which hands out memory by bumping a pointer through a buffer.
+/// Memory is never returned to the arena individually; it is all released at once by Release
+/// or when the arena is destroyed. When the buffer is exhausted, a new block at least twice
+/// the size of the last is allocated from the heap. An arena is not thread safe.
+export class CLinqArena final
+{
+    public:
+        /// The size of the first block allocated by an arena that is not given a buffer.
+        static constexpr std::size_t DefaultBlockSize = 64 * 1024;
+
+        /// Initializes a new instance of the CLinqArena class.
+        /// No memory is allocated until the first allocation from the arena.
+        /// @param blockSize The size of the first block to allocate.
+        explicit CLinqArena(std::size_t const blockSize = DefaultBlockSize) noexcept
+            : _blocks(nullptr),
+              _current(nullptr),
+              _end(nullptr),
+              _buffer(nullptr),
+              _bufferSize(0),
+              _nextBlockSize(std::max(blockSize, MinimumBlockSize)),
+              _bytesAllocated(0)
+        {
+        }
+
+        /// Initializes a new instance of the CLinqArena class which allocates from a caller owned
+        /// buffer, such as one on the stack, before falling back to the heap.
+        /// @param buffer The buffer, which must outlive the arena.
+        /// @param size The size of the buffer in bytes.
+        CLinqArena(void* const buffer, std::size_t const size) noexcept
+            : _blocks(nullptr),
+              _current(static_cast<std::byte*>(buffer)),
+              _end(static_cast<std::byte*>(buffer) + size),
+              _buffer(static_cast<std::byte*>(buffer)),
+              _bufferSize(size),
+              _nextBlockSize(std::max(size * 2, MinimumBlockSize)),
+              _bytesAllocated(0)
+        {
+        }
+
+        CLinqArena(CLinqArena const&) = delete;
+        CLinqArena& operator=(CLinqArena const&) = delete;
+
+        /// Destroys the arena, releasing all of its memory.
+        ~CLinqArena()
+        {
+            FreeBlocks(nullptr);
+        }
+
+        /// Allocates memory from the arena.
+        /// @param size The number of bytes to allocate.
+        /// @param alignment The alignment of the memory, which must be a power of two.
+        /// @returns The allocated memory.
+        /// @throws std::bad_alloc When a new block cannot be allocated.
+        void* Allocate(std::size_t const size, std::size_t const alignment)
+        {
+            auto* memory = TryAllocate(size, alignment);
+            if (memory == nullptr)
+            {
+                AddBlock(size + alignment);
+                memory = TryAllocate(size, alignment);
+            }
+
+            _bytesAllocated += size;
+
+            return memory;
+        }
+
+        /// Gets the number of bytes allocated from the arena since it was created or last released.
+        /// @returns The number of bytes allocated from the arena.
+        std::size_t BytesAllocated() const noexcept
+        {
+            return _bytesAllocated;
+        }
+
+        /// Releases all memory allocated from the arena at once.
+        /// The most recently allocated block is kept for reuse, so that an arena which is released
+        /// after each unit of work stops allocating from the heap once it has grown large enough.
+        /// Nothing allocated from the arena may be used after it is released.
+        void Release() noexcept
+        {
+            if (_blocks != nullptr)
+            {
+                FreeBlocks(_blocks);
+                _current = reinterpret_cast<std::byte*>(_blocks + 1);
+                _end = reinterpret_cast<std::byte*>(_blocks) + _blocks->size;
+            }
+            else
+            {
+                _current = _buffer;
+                _end = _buffer + _bufferSize;
+            }
+
+            _bytesAllocated = 0;
+        }
+
+    private:
+        static constexpr std::size_t MinimumBlockSize = 1024;
+
+        struct Block
+        {
+            Block* previous;
+            std::size_t size;
+        };
+
+        Block* _blocks;
+        std::byte* _current;
+        std::byte* _end;
+        std::byte* _buffer;
+        std::size_t _bufferSize;
+        std::size_t _nextBlockSize;
+        std::size_t _bytesAllocated;
+
+        void* TryAllocate(std::size_t const size, std::size_t const alignment) noexcept
+        {
+            void* memory = _current;
+            auto space = static_cast<std::size_t>(_end - _current);
+            if (_current == nullptr || std::align(alignment, size, memory, space) == nullptr)
+            {
+                return nullptr;
+            }
+
+            _current = static_cast<std::byte*>(memory) + size;
+
+            return memory;
+        }
+
+        void AddBlock(std::size_t const minimumSize)
+        {
+            auto const size = std::max(_nextBlockSize, minimumSize + sizeof(Block));
+            auto* const block = static_cast<Block*>(::operator new(size));
+            block->previous = _blocks;
+            block->size = size;
+
+            _blocks = block;
+            _current = reinterpret_cast<std::byte*>(block + 1);
+            _end = reinterpret_cast<std::byte*>(block) + size;
+            _nextBlockSize = size * 2;
+        }
+
+        void FreeBlocks(Block* const kept) noexcept
+        {
+            auto* block = _blocks;
+            while (block != nullptr)
+            {
+                auto* const previous = block->previous;
+                if (block != kept)
+                {
+                    ::operator delete(block);
+                }
+
+                block = previous;
+            }
+
+            _blocks = kept;
+            if (kept != nullptr)
+            {
+                kept->previous = nullptr;
+            }
+        }
+};
+
+/// An allocator which allocates from a CLinqArena.
+/// Deallocation does nothing; the memory is reclaimed when the arena is released. Copies of the
+/// allocator, including rebound copies, allocate from the same arena, which must outlive every
+/// container using it.
+/// @tparam T The type of objects to allocate.
+export template <typename T>
+class CLinqArenaAllocator
+{
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+        using is_always_equal = std::false_type;
+
+        /// Initializes a new instance of the CLinqArenaAllocator class.
+        /// @param arena The arena to allocate from.
+        CLinqArenaAllocator(CLinqArena& arena) noexcept
+            : _arena(&arena)
+        {
+        }
+
+        /// Initializes a new instance of the CLinqArenaAllocator class from an allocator of another type.
+        /// @tparam U The type of objects allocated by the other allocator.
+        /// @param allocator The other allocator.
+        template <typename U>
+        CLinqArenaAllocator(CLinqArenaAllocator<U> const& allocator) noexcept
+            : _arena(&allocator.Arena())
+        {
+        }
+
+        /// Allocates uninitialized storage for a number of objects.
+        /// @param count The number of objects.
+        /// @returns The allocated storage.
+        T* allocate(std::size_t const count)
+        {
+            if (count > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            {
+                throw std::bad_array_new_length();
+            }
+
+            return static_cast<T*>(_arena->Allocate(count * sizeof(T), alignof(T)));
+        }
+
+        /// Does nothing; memory is reclaimed when the arena is released.
+        void deallocate(T* const, std::size_t const) noexcept
+        {
+        }
+
+        /// Gets the arena the allocator allocates from.
+        /// @returns The arena.
+        CLinqArena& Arena() const noexcept
+        {
+            return *_arena;
+        }
+
+        /// Checks whether the allocators allocate from the same arena.
+        /// @returns True if memory from one allocator can be deallocated by the other.
+        template <typename U>
+        bool operator==(CLinqArenaAllocator<U> const& allocator) const noexcept
+        {
+            return _arena == &allocator.Arena();
+        }
+
+    private:
+        CLinqArena* _arena;
+};
+
+/// A set of keys stored contiguously in insertion order.
+/// Hashable keys are indexed by an open addressing table with linear probing, which only stores
+/// indices into the keys. Keys that cannot be hashed fall back to a linear search.
+/// @tparam TKey The type of keys in the set.
+/// @tparam TAllocator The allocator used for the keys and, rebound, for the index table.
+export template <typename TKey, typename TAllocator = std::allocator<TKey>>
+class CLinqHashSet
+{
+    public:
+        using value_type = TKey;
+        using size_type = std::size_t;
+        using allocator_type = TAllocator;
+
+        /// The index returned when a key is not in the set.
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        /// Initializes a new instance of the CLinqHashSet class.
+        CLinqHashSet() noexcept
+            : CLinqHashSet(TAllocator())
+        {
+        }
+
+        /// Initializes a new instance of the CLinqHashSet class.
+        /// @param allocator The allocator.
+        explicit CLinqHashSet(TAllocator const& allocator) noexcept
+            : _keys(allocator), _hashes(IndexAllocator(allocator)), _slots(IndexAllocator(allocator)), _shift(64)
+        {
+        }
+
+        /// Initializes a new instance of the CLinqHashSet class.
+        /// @param capacity The number of keys to reserve space for.
+        /// @param allocator The allocator.
+        explicit CLinqHashSet(size_type const capacity, TAllocator const& allocator = TAllocator())
+            : CLinqHashSet(allocator)
+        {
+            Reserve(capacity);
+        }
+
+        /// Reserves space for a number of keys without rehashing.
+        /// @param capacity The number of keys to reserve space for.
+        void Reserve(size_type const capacity)
+        {
+            _keys.reserve(capacity);
+
+            if constexpr (CLinqHashable<TKey>)
+            {
+                _hashes.reserve(capacity);
+
+                size_type slotCount = MinimumSlotCount;
+                while (slotCount * MaximumLoadNumerator < capacity * MaximumLoadDenominator)
+                {
+                    slotCount *= 2;
+                }
+
+                if (slotCount > _slots.size())
+                {
+                    Rehash(slotCount);
+                }
+            }
+        }
+
+        /// Inserts a key into the set if it is not already present.
+        /// @param key The key.
+        /// @returns The index of the key in the set and whether or not it was inserted.
+        std::pair<size_type, bool> Insert(TKey const& key)
+        {
+            return InsertCore(key);
+        }
+
+        /// Inserts a key into the set if it is not already present.
+        /// @param key The key.
+        /// @returns The index of the key in the set and whether or not it was inserted.
+        std::pair<size_type, bool> Insert(TKey&& key)
+        {
+            return InsertCore(std::move(key));
+        }
+
+        /// Gets the index of a key in the set.
+        /// @param key The key.
+        /// @returns The index of the key in insertion order, or npos if the key is not in the set.
+        size_type IndexOf(TKey const& key) const
+        {
+            if constexpr (CLinqHashable<TKey>)
+            {
+                if (_slots.empty())
+                {
+                    return npos;
+                }
+
+                auto const hash = std::hash<TKey>{}(key);
+                for (auto slot = SlotOf(hash); _slots[slot] != 0; slot = (slot + 1) & (_slots.size() - 1))
+                {
+                    auto const index = _slots[slot] - 1;
+                    if (_hashes[index] == hash && _keys[index] == key)
+                    {
+                        return index;
+                    }
+                }
+
+                return npos;
+            }
+            else
+            {
+                auto const position = std::find(_keys.begin(), _keys.end(), key);
+
+                return position == _keys.end() ? npos : static_cast<size_type>(position - _keys.begin());
+            }
+        }
+
+        /// Checks whether or not the set contains the given key.
+        /// @param key The key.
+        /// @returns True if the set contains the key, false otherwise.
+        bool Contains(TKey const& key) const
+        {
+            return IndexOf(key) != npos;
+        }
+
+        /// Gets the number of keys in the set.
+        /// @returns The number of keys in the set.
+        size_type Count() const noexcept
+        {
+            return _keys.size();
+        }
+
+        /// Gets the keys in the set in insertion order.
+        /// @returns The keys in the set in insertion order.
+        std::vector<TKey, TAllocator> const& Keys() const& noexcept
+        {
+            return _keys;
+        }
+
+        /// Moves the keys out of the set in insertion order.
+        /// @returns The keys in the set in insertion order.
+        std::vector<TKey, TAllocator> Keys() && noexcept
+        {
+            return std::move(_keys);
+        }
+
+    private:
+        static constexpr size_type MinimumSlotCount = 16;
+        static constexpr size_type MaximumLoadNumerator = 3;
+        static constexpr size_type MaximumLoadDenominator = 4;
+
+        using IndexAllocator = typename std::allocator_traits<TAllocator>::template rebind_alloc<size_type>;
+
+        std::vector<TKey, TAllocator> _keys;
+        std::vector<size_type, IndexAllocator> _hashes;
+        std::vector<size_type, IndexAllocator> _slots;
+        unsigned _shift;
+
+        size_type SlotOf(size_type const hash) const noexcept
+        {
+            // Fibonacci hashing spreads sequential and low-entropy hashes over the whole table.
+            return static_cast<size_type>((static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull) >> _shift);
+        }
+
+        void Rehash(size_type const slotCount)
+        {
+            _slots.assign(slotCount, 0);
+            _shift = 64;
+            for (auto count = slotCount; count > 1; count /= 2)
+            {
+                --_shift;
+            }
+
+            for (size_type index = 0; index < _hashes.size(); ++index)
+            {
+                auto slot = SlotOf(_hashes[index]);
+                while (_slots[slot] != 0)
+                {
+                    slot = (slot + 1) & (_slots.size() - 1);
+                }
+
+                _slots[slot] = index + 1;
+            }
+        }
+
+        template <typename T>
+        std::pair<size_type, bool> InsertCore(T&& key)
+        {
+            if constexpr (CLinqHashable<TKey>)
+            {
+                if ((_keys.size() + 1) * MaximumLoadDenominator > _slots.size() * MaximumLoadNumerator)
+                {
+                    Rehash(std::max(MinimumSlotCount, _slots.size() * 2));
+                }
+
+                auto const hash = std::hash<TKey>{}(key);
+                auto slot = SlotOf(hash);
+                for (; _slots[slot] != 0; slot = (slot + 1) & (_slots.size() - 1))
+                {
+                    auto const index = _slots[slot] - 1;
+                    if (_hashes[index] == hash && _keys[index] == key)
+                    {
+                        return { index, false };
+                    }
+                }
+
+                _keys.emplace_back(std::forward<T>(key));
+                _hashes.emplace_back(hash);
+                _slots[slot] = _keys.size();
+
+                return { _keys.size() - 1, true };
+            }
+            else
+            {
+                auto const index = IndexOf(key);
+                if (index != npos)
+                {
+                    return { index, false };
+                }
+
+                _keys.emplace_back(std::forward<T>(key));
+
+                return { _keys.size() - 1, true };
+            }
+        }
+};
+
+/// A growable array of bools which, unlike std::vector<bool>, stores every bool in its own byte
+/// rather than packing them into bits, so its elements can be referenced and viewed contiguously.
+/// It provides the subset of the std::vector interface used by the containers which store it.
+/// @tparam TAllocator The allocator used for the bools.
+export template <typename TAllocator = std::allocator<bool>>
+class CLinqBoolVector
+{
+    public:
+        using value_type = bool;
+        using size_type = std::size_t;
+        using allocator_type = TAllocator;
+        using reference = bool&;
+        using const_reference = bool const&;
+        using iterator = bool*;
+        using const_iterator = bool const*;
+
+        /// Initializes a new instance of the CLinqBoolVector class.
+        CLinqBoolVector() noexcept
+            : CLinqBoolVector(TAllocator())
+        {
+        }
+
+        /// Initializes a new instance of the CLinqBoolVector class.
+        /// @param allocator The allocator.
+        explicit CLinqBoolVector(TAllocator const& allocator) noexcept
+            : _allocator(allocator), _data(nullptr), _size(0), _capacity(0)
+        {
+        }
+
+        /// Initializes a new instance of the CLinqBoolVector class.
+        /// @param vector The vector to copy.
+        CLinqBoolVector(CLinqBoolVector const& vector)
+            : CLinqBoolVector(AllocatorTraits::select_on_container_copy_construction(vector._allocator))
+        {
+            CopyFrom(vector);
+        }
+
+        /// Initializes a new instance of the CLinqBoolVector class.
+        /// @param vector The vector to move, which is left empty.
+        CLinqBoolVector(CLinqBoolVector&& vector) noexcept
+            : _allocator(std::move(vector._allocator)),
+              _data(std::exchange(vector._data, nullptr)),
+              _size(std::exchange(vector._size, 0)),
+              _capacity(std::exchange(vector._capacity, 0))
+        {
+        }
+
+        /// Frees the bools.
+        ~CLinqBoolVector()
+        {
+            Deallocate();
+        }
+
+        /// Copies the given vector into this vector.
+        /// @param vector The vector to copy.
+        /// @returns This vector.
+        CLinqBoolVector& operator=(CLinqBoolVector const& vector)
+        {
+            if (this != &vector)
+            {
+                if constexpr (AllocatorTraits::propagate_on_container_copy_assignment::value)
+                {
+                    if (_allocator != vector._allocator)
+                    {
+                        Deallocate();
+                    }
+
+                    _allocator = vector._allocator;
+                }
+
+                CopyFrom(vector);
+            }
+
+            return *this;
+        }
+
+        /// Moves the given vector into this vector.
+        /// @param vector The vector to move, which is left empty if its bools were taken.
+        /// @returns This vector.
+        CLinqBoolVector& operator=(CLinqBoolVector&& vector)
+            noexcept(AllocatorTraits::propagate_on_container_move_assignment::value || AllocatorTraits::is_always_equal::value)
+        {
+            if (this == &vector)
+            {
+                return *this;
+            }
+
+            if constexpr (!AllocatorTraits::propagate_on_container_move_assignment::value)
+            {
+                // Bools owned by an unequal allocator cannot be taken, so they are copied instead.
+                if (_allocator != vector._allocator)
+                {
+                    CopyFrom(vector);
+
+                    return *this;
+                }
+            }
+
+            Deallocate();
+            if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value)
+            {
+                _allocator = std::move(vector._allocator);
+            }
+
+            _data = std::exchange(vector._data, nullptr);
+            _size = std::exchange(vector._size, 0);
+            _capacity = std::exchange(vector._capacity, 0);
+
+            return *this;
+        }
+
+        /// Gets a reference to the bool at a given index.
+        /// @param index The index.
+        /// @returns A reference to the bool at the index.
+        bool& operator[](size_type const index) noexcept
+        {
+            return _data[index];
+        }
+
+        /// Gets a const reference to the bool at a given index.
+        /// @param index The index.
+        /// @returns A const reference to the bool at the index.
+        bool const& operator[](size_type const index) const noexcept
+        {
+            return _data[index];
+        }
+
+        /// Checks if the vector holds the same bools as the given vector.
+        /// @param vector The vector to compare to.
+        /// @returns True if the vectors hold the same bools in the same order, false otherwise.
+        bool operator==(CLinqBoolVector const& vector) const noexcept
+        {
+            return std::equal(begin(), end(), vector.begin(), vector.end());
+        }
+
+        /// Gets the allocator used by the vector.
+        /// @returns The allocator used by the vector.
+        allocator_type get_allocator() const noexcept
+        {
+            return _allocator;
+        }
+
+        /// Gets a pointer to the first bool.
+        bool* data() noexcept
+        {
+            return _data;
+        }
+
+        /// Gets a const pointer to the first bool.
+        bool const* data() const noexcept
+        {
+            return _data;
+        }
+
+        /// Gets the iterator at the first bool.
+        iterator begin() noexcept
+        {
+            return _data;
+        }
+
+        /// Gets the iterator after the last bool.
+        iterator end() noexcept
+        {
+            return _data + _size;
+        }
+
+        /// Gets the const iterator at the first bool.
+        const_iterator begin() const noexcept
+        {
+            return _data;
+        }
+
+        /// Gets the const iterator after the last bool.
+        const_iterator end() const noexcept
+        {
+            return _data + _size;
+        }
+
+        /// Gets the number of bools in the vector.
+        /// @returns The number of bools in the vector.
+        size_type size() const noexcept
+        {
+            return _size;
+        }
+
+        /// Gets the number of bools the vector has space for.
+        /// @returns The number of bools the vector has space for.
+        size_type capacity() const noexcept
+        {
+            return _capacity;
+        }
+
+        /// Checks whether or not the vector holds no bools.
+        /// @returns True if the vector is empty, false otherwise.
+        bool empty() const noexcept
+        {
+            return _size == 0;
+        }
+
+        /// Reserves space for a number of bools.
+        /// @param capacity The number of bools to reserve space for.
+        void reserve(size_type const capacity)
+        {
+            if (capacity > _capacity)
+            {
+                Reallocate(capacity);
+            }
+        }
+
+        /// Resizes the vector, adding false bools if it grows.
+        /// @param size The new number of bools.
+        void resize(size_type const size)
+        {
+            reserve(size);
+            if (size > _size)
+            {
+                std::fill(_data + _size, _data + size, false);
+            }
+
+            _size = size;
+        }
+
+        /// Appends a bool to the vector.
+        /// @param value The bool.
+        void push_back(bool const value)
+        {
+            if (_size == _capacity)
+            {
+                Reallocate(std::max<size_type>(_capacity * 2, 16));
+            }
+
+            _data[_size++] = value;
+        }
+
+    private:
+        using AllocatorTraits = std::allocator_traits<TAllocator>;
+
+        static_assert(std::is_same_v<typename AllocatorTraits::value_type, bool>, "CLinqBoolVector must allocate bools.");
+
+        TAllocator _allocator;
+        bool* _data;
+        size_type _size;
+        size_type _capacity;
+
+        void CopyFrom(CLinqBoolVector const& vector)
+        {
+            reserve(vector._size);
+            std::copy(vector.begin(), vector.end(), _data);
+            _size = vector._size;
+        }
+
+        void Reallocate(size_type const capacity)
+        {
+            bool* const data = AllocatorTraits::allocate(_allocator, capacity);
+            std::copy(begin(), end(), data);
+            if (_data != nullptr)
+            {
+                AllocatorTraits::deallocate(_allocator, _data, _capacity);
+            }
+
+            _data = data;
+            _capacity = capacity;
+        }
+
+        void Deallocate() noexcept
+        {
+            if (_data != nullptr)
+            {
+                AllocatorTraits::deallocate(_allocator, _data, _capacity);
+            }
+
+            _data = nullptr;
+            _size = 0;
+            _capacity = 0;
+        }
+};
+
+/// The contiguous storage used by containers for their elements, which is a std::vector except
+/// for bools, which are stored in a CLinqBoolVector so that they can be referenced.
+/// @tparam TElement The type of elements.
+/// @tparam TAllocator The allocator used for the elements.
+export template <typename TElement, typename TAllocator>
+using CLinqContiguousVector = std::conditional_t<
+    std::is_same_v<TElement, bool>,
+    CLinqBoolVector<TAllocator>,
+    std::vector<TElement, TAllocator>>;
+
+/// A map from distinct keys to values, stored as parallel arrays in insertion order.
+/// Keys are indexed by a CLinqHashSet and values are stored contiguously alongside them, so the
+/// map makes a handful of allocations however many entries it holds, and probing only touches
+/// the index table and the key array. Bool values are stored one per byte, so they can be referenced.
+/// @tparam TKey The type of keys in the map.
+/// @tparam TValue The type of values in the map.
+/// @tparam TAllocator The allocator used for the values and, rebound, for the keys.
+export template <typename TKey, typename TValue, typename TAllocator = std::allocator<TValue>>
+class CLinqFlatMap
+{
+    public:
+        using key_type = TKey;
+        using mapped_type = TValue;
+        using size_type = std::size_t;
+        using allocator_type = TAllocator;
+        using key_allocator_type = typename std::allocator_traits<TAllocator>::template rebind_alloc<TKey>;
+
+        /// Initializes a new instance of the CLinqFlatMap class.
+        CLinqFlatMap() noexcept
+            : CLinqFlatMap(TAllocator())
+        {
+        }
+
+        /// Initializes a new instance of the CLinqFlatMap class.
+        /// @param allocator The allocator.
+        explicit CLinqFlatMap(TAllocator const& allocator) noexcept
+            : _keys(key_allocator_type(allocator)), _values(allocator)
+        {
+        }
+
+        /// Initializes a new instance of the CLinqFlatMap class.
+        /// @param capacity The number of entries to reserve space for.
+        /// @param allocator The allocator.
+        explicit CLinqFlatMap(size_type const capacity, TAllocator const& allocator = TAllocator())
+            : CLinqFlatMap(allocator)
+        {
+            Reserve(capacity);
+        }
+
+        /// Gets the allocator used by the map.
+        /// @returns The allocator used by the map.
+        allocator_type get_allocator() const noexcept
+        {
+            return _values.get_allocator();
+        }
+
+        /// Gets the value mapped to a key.
+        /// @param key The key.
+        /// @returns The value mapped to the key.
+        /// @throws CLinqException If the key is not in the map.
+        TValue const& At(TKey const& key) const
+        {
+            auto const* const value = Find(key);
+            if (value == nullptr)
+            {
+                throw CLinqException("Key was not found in map.");
+            }
+
+            return *value;
+        }
+
+        /// Checks whether or not the map contains the given key.
+        /// @param key The key.
+        /// @returns True if the map contains the key, false otherwise.
+        bool Contains(TKey const& key) const
+        {
+            return _keys.Contains(key);
+        }
+
+        /// Gets the number of entries in the map.
+        /// @returns The number of entries in the map.
+        size_type Count() const noexcept
+        {
+            return _values.size();
+        }
+
+        /// Finds the value mapped to a key.
+        /// @param key The key.
+        /// @returns A pointer to the value mapped to the key, or nullptr if the key is not in the map.
+        TValue const* Find(TKey const& key) const
+        {
+            auto const index = _keys.IndexOf(key);
+
+            return index == CLinqHashSet<TKey, key_allocator_type>::npos ? nullptr : &_values[index];
+        }
+
+        /// Maps a key to a value, replacing the value if the key is already in the map.
+        /// @param key The key.
+        /// @param value The value.
+        /// @returns The index of the entry in the map and whether or not the key was inserted.
+        std::pair<size_type, bool> InsertOrAssign(TKey key, TValue value)
+        {
+            // Making room for the value first means a new key is never left without a value.
+            if (_values.size() == _values.capacity())
+            {
+                _values.reserve(std::max<size_type>(_values.capacity() * 2, MinimumCapacity));
+            }
+
+            auto const result = _keys.Insert(std::move(key));
+            if (result.second)
+            {
+                _values.push_back(std::move(value));
+            }
+            else
+            {
+                _values[result.first] = std::move(value);
+            }
+
+            return result;
+        }
+
+        /// Gets the keys in the map in insertion order.
+        /// @returns The keys in the map in insertion order.
+        std::vector<TKey, key_allocator_type> const& Keys() const noexcept
+        {
+            return _keys.Keys();
+        }
+
+        /// Reserves space for a number of entries without rehashing.
+        /// @param capacity The number of entries to reserve space for.
+        void Reserve(size_type const capacity)
+        {
+            _keys.Reserve(capacity);
+            _values.reserve(capacity);
+        }
+
+        /// Gets the values in the map, in the insertion order of their keys.
+        /// @returns The values in the map.
+        CLinqContiguousVector<TValue, TAllocator> const& Values() const noexcept
+        {
+            return _values;
+        }
+
+    private:
+        static constexpr size_type MinimumCapacity = 16;
+
+        CLinqHashSet<TKey, key_allocator_type> _keys;
+        CLinqContiguousVector<TValue, TAllocator> _values;
+};
+
+/// A collection of elements supporting CLinq methods.
+/// @tparam TElement The type of elements in the collection.
+/// @tparam TAllocator The allocator used for the elements of the collection and of every collection
+/// produced from it, rebound where the element type changes.
+export template <typename TElement, typename TAllocator = std::allocator<TElement>>
+class CLinqCollection
+{
+    public:
+        using value_type = TElement;
+        using allocator_type = TAllocator;
+        using size_type = std::vector<TElement, TAllocator>::size_type;
+
+        using iterator = std::vector<TElement, TAllocator>::iterator;
+        using const_iterator = std::vector<TElement, TAllocator>::const_iterator;
+        using reverse_iterator = std::vector<TElement, TAllocator>::reverse_iterator;
+
+        /// Type alias for a function that maps elements to true or false.
+        using MatchFunction = std::function<bool(TElement)>;
+
+        /// Type alias for a function that projects elements to some other type.
+        /// @tparam TProjection The type to project the elements to.
+        template <typename TProjection>
+        using ProjectionFunction = std::function<TProjection(TElement)>;
+
+        /// Type alias for the type an element is projected to by a projection function.
+        /// @tparam TProjector The type of the projection function.
+        template <typename TProjector>
+        using ProjectionResult = std::remove_cvref_t<std::invoke_result_t<TProjector&, TElement const&>>;
+
+        /// Type alias for the allocator of a collection of another element type.
+        /// @tparam T The type of elements to allocate.
+        template <typename T>
+        using RebindAllocator = typename std::allocator_traits<TAllocator>::template rebind_alloc<T>;
+
+        /// Initializes a new instance of the CLinqCollection class.
+        CLinqCollection() noexcept
+            : _elements(std::vector<TElement, TAllocator>())
+        {
+        }
+
+        /// Initializes a new instance of the CLinqCollection class.
+        /// @param allocator The allocator.
+        explicit CLinqCollection(TAllocator const& allocator) noexcept
+            : _elements(allocator)
+        {
+        }
+
+        /// Initializes a new instance of the CLinqCollection class.
+        /// @param elements The initial elements.
+        /// @param allocator The allocator.
+        CLinqCollection(std::initializer_list<TElement> const& elements, TAllocator const& allocator = TAllocator()) noexcept
+            : _elements(std::vector<TElement, TAllocator>(elements.begin(), elements.end(), allocator))
+        {
+        }
+
+        /// Initializes a new instance of the CLinqCollection class.
+        /// @param elements The initial elements.
+        CLinqCollection(std::vector<TElement, TAllocator> const& elements) noexcept
+            : _elements(elements)
+        {
+        }
+
+        /// Initializes a new instance of the CLinqCollection class.
+        /// @param elements The initial elements, which are moved into the collection.
+        CLinqCollection(std::vector<TElement, TAllocator>&& elements) noexcept
+            : _elements(std::move(elements))
+        {
+        }
+
+        /// Initializes a new instance of the CLinqCollection class.
+        /// @param memory A block of memory to copy values from.
+        /// @param numberOfElements The number of elements to copy.
+        /// @param allocator The allocator.
+        explicit CLinqCollection(
+            TElement* const memory,
+            size_type const numberOfElements,
+            TAllocator const& allocator = TAllocator()) noexcept
+            : _elements(std::vector<TElement, TAllocator>(memory, memory + numberOfElements, allocator))
+        {
+        }
+
+        /// Initializes a new instance of the CLinqCollection class.
+        /// @tparam TIterable An iterable type.
+        /// @param iterable The iterable instance.
+        /// @param allocator The allocator.
+        template <CLinqIterable TIterable>
+        explicit CLinqCollection(TIterable& iterable, TAllocator const& allocator = TAllocator())
+            : _elements(allocator)
+        {
+            for (auto& element : iterable)
+            {
+                _elements.emplace_back(element);
+            }
+        }
+
+        /// Gets a reference to the element at a given index of the collection.
+        /// @param i The index.
+        /// @returns A reference to the element at a given index of the collection.
+        TElement& operator[](size_type const i)
+        {
+            return _elements[i];
+        }
+
+        /// Gets a const reference to the element at a given index of the collection.
+        /// @param i The index.
+        /// @returns A const reference to the element at a given index of the collection.
+        TElement const& operator[](size_type const i) const
+        {
+            return _elements[i];
+        }
+
+        /// Spaceship operator.
+        /// @param collection The collection to compare to.
+        /// @returns An ordering comparing this instance and the given collection.
+        auto operator<=>(CLinqCollection<TElement, TAllocator> const&) const = default;
+
+        /// Concatenates this collection with the given collection and returns the result.
+        /// @param collection The collection.
+        /// @returns This instance concatenated with the given collection.
+        CLinqCollection<TElement, TAllocator> operator+(CLinqCollection<TElement, TAllocator> const& collection) const& noexcept
+        {
+            auto newElements = std::vector<TElement, TAllocator>(_elements.get_allocator());
+            newElements.reserve(_elements.size() + collection._elements.size());
+            newElements.insert(newElements.end(), _elements.begin(), _elements.end());
+            newElements.insert(newElements.end(), collection._elements.begin(), collection._elements.end());
+
+            return CLinqCollection<TElement, TAllocator>(std::move(newElements));
+        }
+
+        /// Concatenates this collection with the given collection and returns the result.
+        /// Reuses the storage of this collection, which is left in a valid but unspecified state.
+        /// @param collection The collection.
+        /// @returns This instance concatenated with the given collection.
+        CLinqCollection<TElement, TAllocator> operator+(CLinqCollection<TElement, TAllocator> const& collection) &&
+        {
+            if (&collection == this)
+            {
+                // Inserting a range of a vector into itself is undefined, so the elements are appended by index.
+                auto const numberOfElements = _elements.size();
+                _elements.reserve(numberOfElements * 2);
+
+                for (size_type i = 0; i < numberOfElements; ++i)
+                {
+                    _elements.push_back(_elements[i]);
+                }
+            }
+            else
+            {
+                _elements.insert(_elements.end(), collection._elements.begin(), collection._elements.end());
+            }
+
+            return std::move(*this);
+        }
+
+        /// Gets an empty collection.
+        /// @param allocator The allocator.
+        /// @return An empty collection.
+        static CLinqCollection<TElement, TAllocator> Empty(TAllocator const& allocator = TAllocator())
+        {
+            return CLinqCollection<TElement, TAllocator>(allocator);
+        }
+
+        /// Gets a collection containing the same element n times.
+        /// @param element The element.
+        /// @param count The number of elements.
+        /// @param allocator The allocator.
+        /// @returns A collection containing the same element n times.
+        static CLinqCollection<TElement, TAllocator> Repeat(
+            TElement const& element,
+            size_type const count,
+            TAllocator const& allocator = TAllocator())
+        {
+            return CLinqCollection<TElement, TAllocator>(std::vector<TElement, TAllocator>(count, element, allocator));
+        }
+
+        /// Gets a collection starting from the initial element and prefix incrementing it n times.
+        /// @param initial The initial element.
+        /// @param count The number of elements.
+        /// @param allocator The allocator.
+        /// @returns A collection starting from the initial element and prefix incrementing it n times.
+        static CLinqCollection<TElement, TAllocator> Range(
+            TElement const& initial,
+            size_type const count,
+            TAllocator const& allocator = TAllocator())
+        {
+            auto element = initial;
+            auto elements = std::vector<TElement, TAllocator>(count, allocator);
+
+            for (size_type i = 0; i < count; ++i)
+            {
+                elements[i] = element;
+                ++element;
+            }
+
+            return CLinqCollection<TElement, TAllocator>(std::move(elements));
+        }
+
+        /// Gets the allocator of the collection.
+        /// @returns The allocator of the collection.
+        allocator_type get_allocator() const noexcept
+        {
+            return _elements.get_allocator();
+        }
+
+        /// Gets the iterator at the start of the collection.
+        iterator begin() noexcept
+        {
+            return _elements.begin();
+        }
+
+        /// Gets the iterator at the end of the collection.
+        iterator end() noexcept
+        {
+            return _elements.end();
+        }
+
+        /// Gets the const iterator at the start of the collection.
+        const_iterator cbegin() const noexcept
+        {
+            return _elements.cbegin();
+        }
+
+        /// Gets the const iterator at the end of the collection.
+        const_iterator cend() const noexcept
+        {
+            return _elements.cend();
+        }
+
+        /// Applies an accumulator function over the elements of the collection, in order, starting from a seed.
+        /// @tparam TAccumulate The type of the accumulated value.
+        /// @tparam TAccumulator The type of the accumulator function.
+        /// @param seed The initial accumulated value.
+        /// @param accumulator Combines the accumulated value with the next element.
+        /// @returns The final accumulated value.
+        template <typename TAccumulate, typename TAccumulator>
+            requires std::invocable<TAccumulator&, TAccumulate, TElement const&>
+        TAccumulate Aggregate(TAccumulate seed, TAccumulator&& accumulator) const
+        {
+            return AsView().Aggregate(std::move(seed), accumulator);
+        }
+
+        /// Applies an accumulator function over the elements of the collection, in order, starting from a seed,
+        /// and projects the final accumulated value.
+        /// @tparam TAccumulate The type of the accumulated value.
+        /// @tparam TAccumulator The type of the accumulator function.
+        /// @tparam TResultSelector The type of the result selector.
+        /// @param seed The initial accumulated value.
+        /// @param accumulator Combines the accumulated value with the next element.
+        /// @param resultSelector Projects the final accumulated value.
+        /// @returns The projection of the final accumulated value.
+        template <typename TAccumulate, typename TAccumulator, typename TResultSelector>
+            requires std::invocable<TAccumulator&, TAccumulate, TElement const&> &&
+                std::invocable<TResultSelector&, TAccumulate>
+        auto Aggregate(TAccumulate seed, TAccumulator&& accumulator, TResultSelector&& resultSelector) const
+        {
+            return AsView().Aggregate(std::move(seed), accumulator, resultSelector);
+        }
+
+        /// Checks that every element in the collection matches the given match function.
+        /// @param matchFunction The match function.
+        /// @returns True if every element in the collection matches the given match
+        /// function, false otherwise.
+        bool All(MatchFunction const& matchFunction) const noexcept
+        {
+            return All<MatchFunction const&>(matchFunction);
+        }
+
+        /// Checks that every element in the collection matches the given match function.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns True if every element in the collection matches the given match
+        /// function, false otherwise.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, TElement const&>
+        bool All(TMatch&& matchFunction) const
+        {
+            for (auto& element : _elements)
+            {
+                if (!std::invoke(matchFunction, element))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /// Checks if the collection contains any element.
+        /// @returns True if the collection contains any element, false otherwise.
+        bool Any() const noexcept
+        {
+            return !_elements.empty();
+        }
+
+        /// Checks if the collection contains any element that matches the
+        /// given function.
+        /// @param matchFunction The match function.
+        /// @returns True if the collection contains any element that matches
+        /// the given function, false otherwise.
+        bool Any(MatchFunction const& matchFunction) const noexcept
+        {
+            return Any<MatchFunction const&>(matchFunction);
+        }
+
+        /// Checks if the collection contains any element that matches the
+        /// given function.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns True if the collection contains any element that matches
+        /// the given function, false otherwise.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, TElement const&>
+        bool Any(TMatch&& matchFunction) const
+        {
+            for (auto& element : _elements)
+            {
+                if (std::invoke(matchFunction, element))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /// Appends the element to the collection.
+        /// @param element The element.
+        /// @returns A new collection with the element appended.
+        CLinqCollection<TElement, TAllocator> Append(TElement const& element) const&
+        {
+            auto newElements = std::vector<TElement, TAllocator>(_elements.get_allocator());
+            newElements.reserve(_elements.size() + 1);
+            newElements.insert(newElements.end(), _elements.begin(), _elements.end());
+            newElements.emplace_back(element);
+
+            return CLinqCollection<TElement, TAllocator>(std::move(newElements));
+        }
+
+        /// Appends the element to the collection.
+        /// Reuses the storage of this collection, which is left in a valid but unspecified state.
+        /// @param element The element.
+        /// @returns A new collection with the element appended.
+        CLinqCollection<TElement, TAllocator> Append(TElement const& element) &&
+        {
+            _elements.emplace_back(element);
+
+            return std::move(*this);
+        }
+
+        /// Gets the collection with CLinq methods evaluated across multiple threads.
+        /// The collection must outlive the parallel collection.
+        /// @param degreeOfParallelism The maximum number of threads to use.
+        /// @returns A parallel collection over the elements of the collection.
+        CLinqParallelCollection<TElement> AsParallel(
+            size_type const degreeOfParallelism = CLinqParallelCollection<TElement>::DefaultDegreeOfParallelism()) const& noexcept
+        {
+            return CLinqParallelCollection<TElement>(AsView(), degreeOfParallelism);
+        }
+
+        /// Gets the collection with CLinq methods evaluated across multiple threads.
+        /// The elements are moved into the parallel collection.
+        /// @param degreeOfParallelism The maximum number of threads to use.
+        /// @returns A parallel collection which owns the elements of the collection.
+        CLinqParallelCollection<TElement> AsParallel(
+            size_type const degreeOfParallelism = CLinqParallelCollection<TElement>::DefaultDegreeOfParallelism()) &&
+        {
+            return CLinqParallelCollection<TElement>(std::move(_elements), degreeOfParallelism);
+        }
+
+        /// Gets a lazily evaluated query over the elements of the collection.
+        /// Operators on the query are fused and only evaluated when the query is materialised,
+        /// so the collection must outlive the query.
+        /// @returns A lazily evaluated query over the elements of the collection.
+        CLinqQuery<CLinqIteratorEnumerator<const_iterator>> AsQuery() const noexcept
+        {
+            return CLinqQuery<CLinqIteratorEnumerator<const_iterator>>(
+                CLinqIteratorEnumerator<const_iterator>(_elements.cbegin(), _elements.cend()));
+        }
+
+        /// Gets a non-owning view over the elements of the collection.
+        /// The collection must outlive the view and not be resized while it is in use.
+        /// Collections of bool cannot be viewed, so neither can operators which forward to the view.
+        /// @returns A non-owning view over the elements of the collection.
+        CLinqView<TElement> AsView() const noexcept
+        {
+            static_assert(!std::is_same_v<TElement, bool>,
+                "CLinqCollection<bool> cannot be viewed, as std::vector<bool> does not store its elements contiguously. "
+                "Project to char or std::uint8_t instead.");
+
+            return CLinqView<TElement>(_elements.data(), _elements.size());
+        }
+
+        /// Gets a const reference to the element at given index in the collection.
+        /// @param index The index.
+        /// @returns A const reference to the element at given index in the collection.
+        /// @throws CLinqException When the index is out of range.
+        TElement const& At(size_type const index) const
+        {
+            ThrowIfEmpty();
+            ThrowIfOutOfRange(index);
+
+            return _elements[index];
+        }
+
+        /// Computes the average of the elements in the collection.
+        /// @returns The average of the elements in the collection.
+        /// @throws CLinqException When the collection is empty.
+        double Average() const
+        {
+            return AsView().Average();
+        }
+
+        /// Computes the average of the projections of the elements in the collection.
+        /// @tparam TProjector The type of the projection function.
+        /// @param projectionFunction The projection function.
+        /// @returns The average of the projections of the elements in the collection.
+        /// @throws CLinqException When the collection is empty.
+        template <typename TProjector>
+            requires std::invocable<TProjector&, TElement const&>
+        double Average(TProjector&& projectionFunction) const
+        {
+            return AsView().Average(projectionFunction);
+        }
+
+        /// Splits the collection into contiguous chunks of a given size without copying any elements.
+        /// Each chunk is a view over the elements of the collection, so the collection must outlive
+        /// the chunks and not be resized while they are in use. The last chunk may be smaller.
+        /// @param chunkSize The number of elements in each chunk.
+        /// @returns A collection of views over consecutive chunks of the collection.
+        /// @throws CLinqException When the chunk size is 0.
+        CLinqCollection<CLinqView<TElement>, RebindAllocator<CLinqView<TElement>>> Chunk(size_type const chunkSize) const&
+        {
+            return AsView().Chunk(chunkSize, RebindAllocator<CLinqView<TElement>>(_elements.get_allocator()));
+        }
+
+        /// Chunking a temporary collection would leave every chunk dangling.
+        CLinqCollection<CLinqView<TElement>, RebindAllocator<CLinqView<TElement>>> Chunk(size_type const chunkSize) && = delete;
+
+        /// Concatenates the two collections and returns the result as a new instance.
+        /// @param collection The collection.
+        /// @returns The two collections concatenated.
+        CLinqCollection<TElement, TAllocator> Concat(CLinqCollection<TElement, TAllocator> collection) const&
         {
             return *this + collection;
         }
 
-        /// Checks whether or not the collection contains the given element.
-        /// @param element The element to find.
-        /// @returns True if the set contains the given element, false otherwise.
-        bool Contains(TElement const& element) const
+        /// Concatenates the two collections and returns the result as a new instance.
+        /// Reuses the storage of this collection, which is left in a valid but unspecified state.
+        /// @param collection The collection.
+        /// @returns The two collections concatenated.
+        CLinqCollection<TElement, TAllocator> Concat(CLinqCollection<TElement, TAllocator> collection) &&
+        {
+            return std::move(*this) + collection;
+        }
+
+        /// Checks whether or not the collection contains the given element.
+        /// @param element The element to find.
+        /// @returns True if the set contains the given element, false otherwise.
+        bool Contains(TElement const& element) const
+        {
+            return VectorContains(_elements, element);
+        }
+
+        /// Gets the number of elements in the collection.
+        /// @returns The number of elements in the collection.
+        size_type Count() const noexcept
+        {
+            return _elements.size();
+        }
+
+        /// Gets the number of elements in the collection that match the given match function.
+        /// @param matchFunction The match function.
+        /// @returns The number of elements that match the given match function.
+        size_type Count(MatchFunction const& matchFunction) const
+        {
+            return Count<MatchFunction const&>(matchFunction);
+        }
+
+        /// Gets the number of elements in the collection that match the given match function.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns The number of elements that match the given match function.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, TElement const&>
+        size_type Count(TMatch&& matchFunction) const
+        {
+            size_type count = 0;
+
+            for (auto& element : _elements)
+            {
+                if (std::invoke(matchFunction, element))
+                {
+                    ++count;
+                }
+            }
+
+            return count;
+        }
+
+        /// Gets the distinct elements of the collection.
+        /// @returns Gets the distinct elements of the collection.
+        CLinqCollection<TElement, TAllocator> Distinct() const
+        {
+            return CLinqCollection<TElement, TAllocator>(ToHashSet().Keys());
+        }
+
+        /// Computes the running results of an accumulator function over the elements of the collection,
+        /// starting from a seed, excluding the element at each index. The first result is the seed, and each
+        /// later result is the accumulator applied to the previous result and the previous element.
+        /// Running sums of arithmetic elements are computed with a vectorised kernel where available, so
+        /// floating point sums may differ in rounding from a sequential scan.
+        /// @tparam TAccumulate The type of the accumulated value.
+        /// @tparam TAccumulator The type of the accumulator function.
+        /// @param seed The first result.
+        /// @param accumulator Combines the previous result with the next element.
+        /// @returns The running results, one for each element.
+        template <typename TAccumulate, typename TAccumulator>
+            requires std::invocable<TAccumulator&, TAccumulate, TElement const&>
+        CLinqCollection<TAccumulate, RebindAllocator<TAccumulate>> ExclusiveScan(TAccumulate seed, TAccumulator&& accumulator) const
+        {
+            auto results = std::vector<TAccumulate, RebindAllocator<TAccumulate>>(RebindAllocator<TAccumulate>(_elements.get_allocator()));
+
+            if (!_elements.empty())
+            {
+                results.reserve(_elements.size());
+                results.push_back(seed);
+                ScanCore(results, _elements.size() - 1, std::move(seed), accumulator);
+            }
+
+            return CLinqCollection<TAccumulate, RebindAllocator<TAccumulate>>(std::move(results));
+        }
+
+        /// Gets the elements in this collection with elements in the given collection omitted.
+        /// @param collection The collection.
+        /// @returns The elements in this collection with elements in the given collection omitted.
+        CLinqCollection<TElement, TAllocator> Except(CLinqCollection<TElement, TAllocator> const& collection) const
+        {
+            auto newElements = std::vector<TElement, TAllocator>(_elements.get_allocator());
+            auto const omittedElements = collection.ToHashSet();
+
+            for (auto& element : _elements)
+            {
+                if (!omittedElements.Contains(element))
+                {
+                    newElements.emplace_back(element);
+                }
+            }
+
+            return CLinqCollection<TElement, TAllocator>(std::move(newElements));
+        }
+
+        /// Gets a const reference to the first element in the collection.
+        /// @returns A const reference to the first element in the collection.
+        TElement const& First() const
+        {
+            ThrowIfEmpty();
+
+            return _elements.front();
+        }
+
+        /// Groups the elements of the collection by key.
+        /// Each key is computed once. The elements of every group are stored in one contiguous buffer,
+        /// so the number of allocations does not depend on the number of groups.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
+        /// @returns A lookup from each key to its elements, with groups in order of first appearance of their key.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, TElement const&>
+        CLinqLookup<ProjectionResult<TKeySelector>, TElement, TAllocator> GroupBy(TKeySelector&& keySelector) const&
+        {
+            return GroupByCore<TElement>(keySelector, [this](size_type const index) -> TElement const&
+            {
+                return _elements[index];
+            });
+        }
+
+        /// Groups the elements of the collection by key.
+        /// Each key is computed once. The elements of every group are stored in one contiguous buffer,
+        /// so the number of allocations does not depend on the number of groups.
+        /// The elements are moved out of this collection, which is left in a valid but unspecified state.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
+        /// @returns A lookup from each key to its elements, with groups in order of first appearance of their key.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, TElement const&>
+        CLinqLookup<ProjectionResult<TKeySelector>, TElement, TAllocator> GroupBy(TKeySelector&& keySelector) &&
+        {
+            return GroupByCore<TElement>(keySelector, [this](size_type const index) -> TElement&&
+            {
+                return std::move(_elements[index]);
+            });
+        }
+
+        /// Groups projections of the elements of the collection by key.
+        /// Each key and projection is computed once. The projections of every group are stored in one
+        /// contiguous buffer, so the number of allocations does not depend on the number of groups.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @tparam TElementSelector The type of the element selector.
+        /// @param keySelector The key selector.
+        /// @param elementSelector The projection of each element to store in its group.
+        /// @returns A lookup from each key to its projections, with groups in order of first appearance of their key.
+        template <typename TKeySelector, typename TElementSelector>
+            requires std::invocable<TKeySelector&, TElement const&> && std::invocable<TElementSelector&, TElement const&>
+        CLinqLookup<ProjectionResult<TKeySelector>, ProjectionResult<TElementSelector>, RebindAllocator<ProjectionResult<TElementSelector>>> GroupBy(
+            TKeySelector&& keySelector,
+            TElementSelector&& elementSelector) const
+        {
+            return GroupByCore<ProjectionResult<TElementSelector>>(keySelector, [this, &elementSelector](size_type const index)
+            {
+                return std::invoke(elementSelector, _elements[index]);
+            });
+        }
+
+        /// Correlates each element of the collection with the group of inner elements with an equal key.
+        /// The inner elements are grouped by key in a hash table, which is then probed once per element.
+        /// The views passed to the result selector are only valid for the duration of the call.
+        /// @tparam TInner The type of inner elements.
+        /// @tparam TInnerAllocator The type of allocator of the inner collection.
+        /// @tparam TOuterKeySelector The type of the key selector for the elements of this collection.
+        /// @tparam TInnerKeySelector The type of the key selector for the inner elements.
+        /// @tparam TResultSelector The type of the result selector.
+        /// @param inner The inner collection.
+        /// @param outerKeySelector The key selector for the elements of this collection.
+        /// @param innerKeySelector The key selector for the inner elements.
+        /// @param resultSelector Makes the result for an element and a view over its matching inner elements.
+        /// @returns A new collection with one result for each element, in order.
+        template <typename TInner, typename TInnerAllocator, typename TOuterKeySelector, typename TInnerKeySelector, typename TResultSelector>
+            requires std::invocable<TOuterKeySelector&, TElement const&> &&
+                std::invocable<TInnerKeySelector&, TInner const&> &&
+                std::invocable<TResultSelector&, TElement const&, CLinqView<TInner>>
+        auto GroupJoin(
+            CLinqCollection<TInner, TInnerAllocator> const& inner,
+            TOuterKeySelector&& outerKeySelector,
+            TInnerKeySelector&& innerKeySelector,
+            TResultSelector&& resultSelector) const
+        {
+            return GroupJoin(inner.GroupBy(innerKeySelector), outerKeySelector, resultSelector);
+        }
+
+        /// Correlates each element of the collection with the group of inner elements with an equal key,
+        /// using a prebuilt lookup of the inner elements, such as one made by GroupBy. The lookup can be
+        /// reused across joins.
+        /// @tparam TKey The type of keys in the lookup.
+        /// @tparam TInner The type of inner elements.
+        /// @tparam TInnerAllocator The type of allocator of the lookup.
+        /// @tparam TOuterKeySelector The type of the key selector for the elements of this collection.
+        /// @tparam TResultSelector The type of the result selector.
+        /// @param inner The lookup of inner elements by key.
+        /// @param outerKeySelector The key selector for the elements of this collection.
+        /// @param resultSelector Makes the result for an element and a view over its matching inner elements.
+        /// @returns A new collection with one result for each element, in order.
+        template <typename TKey, typename TInner, typename TInnerAllocator, typename TOuterKeySelector, typename TResultSelector>
+            requires std::invocable<TOuterKeySelector&, TElement const&> &&
+                std::invocable<TResultSelector&, TElement const&, CLinqView<TInner>>
+        auto GroupJoin(
+            CLinqLookup<TKey, TInner, TInnerAllocator> const& inner,
+            TOuterKeySelector&& outerKeySelector,
+            TResultSelector&& resultSelector) const
+        {
+            using TResult = std::remove_cvref_t<std::invoke_result_t<TResultSelector&, TElement const&, CLinqView<TInner>>>;
+
+            auto newElements = std::vector<TResult, RebindAllocator<TResult>>(RebindAllocator<TResult>(_elements.get_allocator()));
+            newElements.reserve(_elements.size());
+
+            for (auto const& element : _elements)
+            {
+                newElements.emplace_back(std::invoke(resultSelector, element, inner[std::invoke(outerKeySelector, element)]));
+            }
+
+            return CLinqCollection<TResult, RebindAllocator<TResult>>(std::move(newElements));
+        }
+
+        /// Computes the set intersection of this collection and the given collection.
+        /// @param collection The collection.
+        /// @returns The set intersection of this collection and the given collection.
+        CLinqCollection<TElement, TAllocator> Intersection(CLinqCollection<TElement, TAllocator> const& collection) const
+        {
+            auto newElements = std::vector<TElement, TAllocator>(_elements.get_allocator());
+            auto const intersectingElements = collection.ToHashSet();
+
+            for (auto& element : _elements)
+            {
+                if (intersectingElements.Contains(element))
+                {
+                    newElements.emplace_back(element);
+                }
+            }
+
+            return CLinqCollection<TElement, TAllocator>(std::move(newElements));
+        }
+
+        /// Correlates the elements of the collection with the inner elements with an equal key.
+        /// The smaller of the two collections is grouped by key in a hash table, which is probed with
+        /// the elements of the larger, so the join takes O(n + m) time plus the number of results.
+        /// @tparam TInner The type of inner elements.
+        /// @tparam TInnerAllocator The type of allocator of the inner collection.
+        /// @tparam TOuterKeySelector The type of the key selector for the elements of this collection.
+        /// @tparam TInnerKeySelector The type of the key selector for the inner elements.
+        /// @tparam TResultSelector The type of the result selector.
+        /// @param inner The inner collection.
+        /// @param outerKeySelector The key selector for the elements of this collection.
+        /// @param innerKeySelector The key selector for the inner elements.
+        /// @param resultSelector Makes the result for an element and a matching inner element.
+        /// @returns A new collection with a result for each matching pair, ordered by the elements of this
+        /// collection and then by the inner elements.
+        template <typename TInner, typename TInnerAllocator, typename TOuterKeySelector, typename TInnerKeySelector, typename TResultSelector>
+            requires std::invocable<TOuterKeySelector&, TElement const&> &&
+                std::invocable<TInnerKeySelector&, TInner const&> &&
+                std::invocable<TResultSelector&, TElement const&, TInner const&>
+        auto Join(
+            CLinqCollection<TInner, TInnerAllocator> const& inner,
+            TOuterKeySelector&& outerKeySelector,
+            TInnerKeySelector&& innerKeySelector,
+            TResultSelector&& resultSelector) const
+        {
+            using TResult = std::remove_cvref_t<std::invoke_result_t<TResultSelector&, TElement const&, TInner const&>>;
+
+            auto newElements = std::vector<TResult, RebindAllocator<TResult>>(RebindAllocator<TResult>(_elements.get_allocator()));
+
+            if (inner.Count() <= _elements.size())
+            {
+                auto const innerIndex = inner.GroupBy(innerKeySelector, [](TInner const& element) { return &element; });
+
+                for (auto const& element : _elements)
+                {
+                    for (auto const* const match : innerIndex[std::invoke(outerKeySelector, element)])
+                    {
+                        newElements.emplace_back(std::invoke(resultSelector, element, *match));
+                    }
+                }
+
+                return CLinqCollection<TResult, RebindAllocator<TResult>>(std::move(newElements));
+            }
+
+            // The elements of this collection are indexed instead, so the matches are found in order of
+            // the inner elements. They are then put back in order of the elements of this collection
+            // with a counting sort, which keeps the order of the inner elements for each element.
+            auto const outerIndex = GroupBy(outerKeySelector, [](TElement const& element) { return &element; });
+            auto matches = std::vector<std::pair<size_type, TInner const*>, RebindAllocator<std::pair<size_type, TInner const*>>>(
+                RebindAllocator<std::pair<size_type, TInner const*>>(_elements.get_allocator()));
+
+            for (auto match = inner.cbegin(); match != inner.cend(); ++match)
+            {
+                for (auto const* const element : outerIndex[std::invoke(innerKeySelector, *match)])
+                {
+                    matches.emplace_back(static_cast<size_type>(element - _elements.data()), &*match);
+                }
+            }
+
+            auto ends = std::vector<size_type, RebindAllocator<size_type>>(_elements.size() + 1, 0, RebindAllocator<size_type>(_elements.get_allocator()));
+            for (auto const& match : matches)
+            {
+                ++ends[match.first + 1];
+            }
+
+            std::partial_sum(ends.begin(), ends.end(), ends.begin());
+
+            auto orderedMatches = std::vector<TInner const*, RebindAllocator<TInner const*>>(
+                matches.size(), RebindAllocator<TInner const*>(_elements.get_allocator()));
+            for (auto const& match : matches)
+            {
+                orderedMatches[ends[match.first]++] = match.second;
+            }
+
+            newElements.reserve(matches.size());
+            size_type start = 0;
+            for (size_type i = 0; i < _elements.size(); ++i)
+            {
+                for (; start < ends[i]; ++start)
+                {
+                    newElements.emplace_back(std::invoke(resultSelector, _elements[i], *orderedMatches[start]));
+                }
+            }
+
+            return CLinqCollection<TResult, RebindAllocator<TResult>>(std::move(newElements));
+        }
+
+        /// Correlates the elements of the collection with the inner elements with an equal key, using a
+        /// prebuilt lookup of the inner elements, such as one made by GroupBy. The lookup can be reused
+        /// across joins, and is probed once per element.
+        /// @tparam TKey The type of keys in the lookup.
+        /// @tparam TInner The type of inner elements.
+        /// @tparam TInnerAllocator The type of allocator of the lookup.
+        /// @tparam TOuterKeySelector The type of the key selector for the elements of this collection.
+        /// @tparam TResultSelector The type of the result selector.
+        /// @param inner The lookup of inner elements by key.
+        /// @param outerKeySelector The key selector for the elements of this collection.
+        /// @param resultSelector Makes the result for an element and a matching inner element.
+        /// @returns A new collection with a result for each matching pair, ordered by the elements of this
+        /// collection and then by the inner elements.
+        template <typename TKey, typename TInner, typename TInnerAllocator, typename TOuterKeySelector, typename TResultSelector>
+            requires std::invocable<TOuterKeySelector&, TElement const&> &&
+                std::invocable<TResultSelector&, TElement const&, TInner const&>
+        auto Join(
+            CLinqLookup<TKey, TInner, TInnerAllocator> const& inner,
+            TOuterKeySelector&& outerKeySelector,
+            TResultSelector&& resultSelector) const
+        {
+            using TResult = std::remove_cvref_t<std::invoke_result_t<TResultSelector&, TElement const&, TInner const&>>;
+
+            auto newElements = std::vector<TResult, RebindAllocator<TResult>>(RebindAllocator<TResult>(_elements.get_allocator()));
+
+            for (auto const& element : _elements)
+            {
+                for (auto const& match : inner[std::invoke(outerKeySelector, element)])
+                {
+                    newElements.emplace_back(std::invoke(resultSelector, element, match));
+                }
+            }
+
+            return CLinqCollection<TResult, RebindAllocator<TResult>>(std::move(newElements));
+        }
+
+        /// Gets a const reference to the last element in the collection.
+        /// @returns A const reference to the last element in the collection.
+        TElement const& Last() const
+        {
+            ThrowIfEmpty();
+
+            return _elements.back();
+        }
+
+        /// Gets the greatest element in the collection.
+        /// @returns The greatest element in the collection.
+        /// @throws CLinqException When the collection is empty.
+        TElement Max() const
+        {
+            return AsView().Max();
+        }
+
+        /// Gets the greatest projection of the elements in the collection.
+        /// @tparam TProjector The type of the projection function.
+        /// @param projectionFunction The projection function.
+        /// @returns The greatest projection of the elements in the collection.
+        /// @throws CLinqException When the collection is empty.
+        template <typename TProjector>
+            requires std::invocable<TProjector&, TElement const&>
+        ProjectionResult<TProjector> Max(TProjector&& projectionFunction) const
+        {
+            return AsView().Max(projectionFunction);
+        }
+
+        /// Gets the first element in the collection with the greatest key.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
+        /// @returns A const reference to the first element in the collection with the greatest key.
+        /// @throws CLinqException When the collection is empty.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, TElement const&>
+        TElement const& MaxBy(TKeySelector&& keySelector) const
+        {
+            return AsView().MaxBy(keySelector);
+        }
+
+        /// Gets the least element in the collection.
+        /// @returns The least element in the collection.
+        /// @throws CLinqException When the collection is empty.
+        TElement Min() const
+        {
+            return AsView().Min();
+        }
+
+        /// Gets the least projection of the elements in the collection.
+        /// @tparam TProjector The type of the projection function.
+        /// @param projectionFunction The projection function.
+        /// @returns The least projection of the elements in the collection.
+        /// @throws CLinqException When the collection is empty.
+        template <typename TProjector>
+            requires std::invocable<TProjector&, TElement const&>
+        ProjectionResult<TProjector> Min(TProjector&& projectionFunction) const
+        {
+            return AsView().Min(projectionFunction);
+        }
+
+        /// Gets the first element in the collection with the least key.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
+        /// @returns A const reference to the first element in the collection with the least key.
+        /// @throws CLinqException When the collection is empty.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, TElement const&>
+        TElement const& MinBy(TKeySelector&& keySelector) const
+        {
+            return AsView().MinBy(keySelector);
+        }
+
+        /// Stably sorts the elements of the collection in ascending order of key.
+        /// Each key is computed exactly once. Arithmetic and enumeration keys are radix sorted.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
+        /// @returns The sorted collection, which can be further sorted with ThenBy.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, TElement const&>
+        CLinqOrderedCollection<TElement, TAllocator> OrderBy(TKeySelector&& keySelector) const&
+        {
+            return OrderByCore(_elements, keySelector, false);
+        }
+
+        /// Stably sorts the elements of the collection in ascending order of key.
+        /// Each key is computed exactly once. Arithmetic and enumeration keys are radix sorted.
+        /// The elements are moved out of this collection, which is left in a valid but unspecified state.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
+        /// @returns The sorted collection, which can be further sorted with ThenBy.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, TElement const&>
+        CLinqOrderedCollection<TElement, TAllocator> OrderBy(TKeySelector&& keySelector) &&
+        {
+            return OrderByCore(std::move(_elements), keySelector, false);
+        }
+
+        /// Stably sorts the elements of the collection in descending order of key.
+        /// Each key is computed exactly once. Arithmetic and enumeration keys are radix sorted.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
+        /// @returns The sorted collection, which can be further sorted with ThenBy.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, TElement const&>
+        CLinqOrderedCollection<TElement, TAllocator> OrderByDescending(TKeySelector&& keySelector) const&
+        {
+            return OrderByCore(_elements, keySelector, true);
+        }
+
+        /// Stably sorts the elements of the collection in descending order of key.
+        /// Each key is computed exactly once. Arithmetic and enumeration keys are radix sorted.
+        /// The elements are moved out of this collection, which is left in a valid but unspecified state.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
+        /// @returns The sorted collection, which can be further sorted with ThenBy.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, TElement const&>
+        CLinqOrderedCollection<TElement, TAllocator> OrderByDescending(TKeySelector&& keySelector) &&
+        {
+            return OrderByCore(std::move(_elements), keySelector, true);
+        }
+
+        /// Prepends the element to the collection.
+        /// @param element The element.
+        /// @returns A new collection with the element prepended.
+        CLinqCollection<TElement, TAllocator> Prepend(TElement const& element) const&
+        {
+            auto newElements = std::vector<TElement, TAllocator>(_elements.get_allocator());
+            newElements.reserve(_elements.size() + 1);
+            newElements.emplace_back(element);
+            newElements.insert(newElements.end(), _elements.begin(), _elements.end());
+
+            return CLinqCollection<TElement, TAllocator>(std::move(newElements));
+        }
+
+        /// Prepends the element to the collection.
+        /// Reuses the storage of this collection, which is left in a valid but unspecified state.
+        /// @param element The element.
+        /// @returns A new collection with the element prepended.
+        CLinqCollection<TElement, TAllocator> Prepend(TElement const& element) &&
+        {
+            _elements.emplace(_elements.begin(), element);
+
+            return std::move(*this);
+        }
+
+        /// Gets the collection in reverse order.
+        /// @returns The collection in reverse order.
+        CLinqCollection<TElement, TAllocator> Reverse() const&
+        {
+            auto newElements = _elements;
+            std::reverse(newElements.begin(), newElements.end());
+            return CLinqCollection<TElement, TAllocator>(std::move(newElements));
+        }
+
+        /// Gets the collection in reverse order.
+        /// Reuses the storage of this collection, which is left in a valid but unspecified state.
+        /// @returns The collection in reverse order.
+        CLinqCollection<TElement, TAllocator> Reverse() &&
+        {
+            std::reverse(_elements.begin(), _elements.end());
+
+            return std::move(*this);
+        }
+
+        /// Computes the running results of an accumulator function over the elements of the collection,
+        /// starting from a seed. Each result is the accumulator applied to the previous result, or the seed,
+        /// and the element at its index. Running sums of arithmetic elements are computed with a vectorised
+        /// kernel where available, so floating point sums may differ in rounding from a sequential scan.
+        /// @tparam TAccumulate The type of the accumulated value.
+        /// @tparam TAccumulator The type of the accumulator function.
+        /// @param seed The value preceding the first result.
+        /// @param accumulator Combines the previous result with the next element.
+        /// @returns The running results, one for each element.
+        template <typename TAccumulate, typename TAccumulator>
+            requires std::invocable<TAccumulator&, TAccumulate, TElement const&>
+        CLinqCollection<TAccumulate, RebindAllocator<TAccumulate>> Scan(TAccumulate seed, TAccumulator&& accumulator) const
+        {
+            auto results = std::vector<TAccumulate, RebindAllocator<TAccumulate>>(RebindAllocator<TAccumulate>(_elements.get_allocator()));
+            ScanCore(results, _elements.size(), std::move(seed), accumulator);
+
+            return CLinqCollection<TAccumulate, RebindAllocator<TAccumulate>>(std::move(results));
+        }
+
+        /// Projects each element to a new sequence using the projection function.
+        /// @tparam TProjection The type to project the elements to.
+        /// @param projectionFunction The projection function/
+        /// @returns Each element projected into a new sequence.
+        template <typename TProjection>
+        CLinqCollection<TProjection, RebindAllocator<TProjection>> Select(
+            ProjectionFunction<TProjection> const& projectionFunction) const
+        {
+            return Select<TProjection, ProjectionFunction<TProjection> const&>(projectionFunction);
+        }
+
+        /// Projects each element to a new sequence using the projection function.
+        /// @tparam TProjection The type to project the elements to. Defaults to the result type of the projection function.
+        /// @tparam TProjector The type of the projection function.
+        /// @param projectionFunction The projection function.
+        /// @returns Each element projected into a new sequence.
+        template <typename TProjection = void, typename TProjector>
+            requires std::invocable<TProjector&, TElement const&>
+        CLinqCollection<
+            std::conditional_t<std::is_void_v<TProjection>, ProjectionResult<TProjector>, TProjection>,
+            RebindAllocator<std::conditional_t<std::is_void_v<TProjection>, ProjectionResult<TProjector>, TProjection>>> Select(
+            TProjector&& projectionFunction) const
+        {
+            using TResult = std::conditional_t<std::is_void_v<TProjection>, ProjectionResult<TProjector>, TProjection>;
+
+            auto newElements = std::vector<TResult, RebindAllocator<TResult>>(
+                RebindAllocator<TResult>(_elements.get_allocator()));
+            newElements.reserve(_elements.size());
+
+            for (auto& element : _elements)
+            {
+                newElements.emplace_back(std::invoke(projectionFunction, element));
+            }
+
+            return CLinqCollection<TResult, RebindAllocator<TResult>>(std::move(newElements));
+        }
+
+        /// Projects each element to a range and flattens the ranges into one collection.
+        /// When the collection selector returns a sized view or a reference to a sized range, such as a
+        /// member of each element, the total size is computed first so the result is allocated exactly once.
+        /// @tparam TCollectionSelector The type of the collection selector.
+        /// @param collectionSelector Projects each element to a range of inner elements.
+        /// @returns The inner elements of every element, in order.
+        template <typename TCollectionSelector>
+            requires CLinqCollectionSelector<TCollectionSelector, TElement const&>
+        auto SelectMany(TCollectionSelector&& collectionSelector) const
+        {
+            using TInner = std::invoke_result_t<TCollectionSelector&, TElement const&>;
+
+            return SelectManyCore<std::ranges::range_value_t<std::remove_cvref_t<TInner>>>(collectionSelector, CLinqSelectInner());
+        }
+
+        /// Projects each element to a range and projects each pair of element and inner element to a
+        /// new collection. When the collection selector returns a sized view or a reference to a sized range,
+        /// such as a member of each element, the total size is computed first so the result is allocated exactly once.
+        /// @tparam TCollectionSelector The type of the collection selector.
+        /// @tparam TResultSelector The type of the result selector.
+        /// @param collectionSelector Projects each element to a range of inner elements.
+        /// @param resultSelector Projects an element and one of its inner elements to a result.
+        /// @returns The results for every inner element of every element, in order.
+        template <typename TCollectionSelector, typename TResultSelector>
+            requires CLinqCollectionSelector<TCollectionSelector, TElement const&> &&
+                std::invocable<
+                    TResultSelector&,
+                    TElement const&,
+                    std::ranges::range_reference_t<std::invoke_result_t<TCollectionSelector&, TElement const&>>>
+        auto SelectMany(TCollectionSelector&& collectionSelector, TResultSelector&& resultSelector) const
+        {
+            using TInner = std::invoke_result_t<TCollectionSelector&, TElement const&>;
+
+            return SelectManyCore<std::remove_cvref_t<std::invoke_result_t<
+                TResultSelector&,
+                TElement const&,
+                std::ranges::range_reference_t<TInner>>>>(collectionSelector, resultSelector);
+        }
+
+        /// Returns the only element of the sequence.
+        /// @returns A reference to the single element of the sequence.
+        /// @throws CLinqException If 0 or many elements are contained within the collection.
+        TElement const& Single() const
+        {
+            ThrowIfEmpty();
+            if (_elements.size() > 1)
+            {
+                throw CLinqException("Collection contains more than 1 element.");
+            }
+
+            return _elements[0];
+        }
+
+        /// Skips a given number of elements and returns the rest.
+        /// @param numberOfElements The number of elements to skip.
+        /// @returns The remainder of the elements after skipping n.
+        CLinqCollection<TElement, TAllocator> Skip(size_type const numberOfElements) const&
+        {
+            if (numberOfElements > _elements.size())
+            {
+                throw CLinqException("Cannot skip more elements than exist in collection.");
+            }
+
+            return CLinqCollection<TElement, TAllocator>(std::vector<TElement, TAllocator>(
+                _elements.begin() + numberOfElements, _elements.end(),
+                _elements.get_allocator()));
+        }
+
+        /// Skips a given number of elements and returns the rest.
+        /// Reuses the storage of this collection, which is left in a valid but unspecified state.
+        /// @param numberOfElements The number of elements to skip.
+        /// @returns The remainder of the elements after skipping n.
+        CLinqCollection<TElement, TAllocator> Skip(size_type const numberOfElements) &&
+        {
+            if (numberOfElements > _elements.size())
+            {
+                throw CLinqException("Cannot skip more elements than exist in collection.");
+            }
+
+            _elements.erase(_elements.begin(), _elements.begin() + numberOfElements);
+
+            return std::move(*this);
+        }
+
+        /// Skips a given number of elements from the back of the collection and returns the rest.
+        /// @param numberOfElements The number of elements to skip from the back.
+        /// @returns The remainder of the elements after skipping n from the back of the collection.
+        CLinqCollection<TElement, TAllocator> SkipLast(size_type const numberOfElements) const&
+        {
+            if (numberOfElements > _elements.size())
+            {
+                throw CLinqException("Cannot skip more elements than exist in collection.");
+            }
+
+            return CLinqCollection<TElement, TAllocator>(std::vector<TElement, TAllocator>(
+                _elements.begin(), _elements.end() - numberOfElements,
+                _elements.get_allocator()));
+        }
+
+        /// Skips a given number of elements from the back of the collection and returns the rest.
+        /// Reuses the storage of this collection, which is left in a valid but unspecified state.
+        /// @param numberOfElements The number of elements to skip from the back.
+        /// @returns The remainder of the elements after skipping n from the back of the collection.
+        CLinqCollection<TElement, TAllocator> SkipLast(size_type const numberOfElements) &&
+        {
+            if (numberOfElements > _elements.size())
+            {
+                throw CLinqException("Cannot skip more elements than exist in collection.");
+            }
+
+            _elements.erase(_elements.end() - numberOfElements, _elements.end());
+
+            return std::move(*this);
+        }
+
+        /// Skips elements while the match function returns true and returns the remainder of the collection.
+        /// @param matchFunction The match function.
+        /// @returns A new collection with the elements skipped until the match function returns false.
+        CLinqCollection<TElement, TAllocator> SkipWhile(MatchFunction const& matchFunction) const&
+        {
+            return SkipWhile<MatchFunction const&>(matchFunction);
+        }
+
+        /// Skips elements while the match function returns true and returns the remainder of the collection.
+        /// Reuses the storage of this collection, which is left in a valid but unspecified state.
+        /// @param matchFunction The match function.
+        /// @returns A new collection with the elements skipped until the match function returns false.
+        CLinqCollection<TElement, TAllocator> SkipWhile(MatchFunction const& matchFunction) &&
+        {
+            return std::move(*this).template SkipWhile<MatchFunction const&>(matchFunction);
+        }
+
+        /// Skips elements while the match function returns true and returns the remainder of the collection.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns A new collection with the elements skipped until the match function returns false.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, TElement const&>
+        CLinqCollection<TElement, TAllocator> SkipWhile(TMatch&& matchFunction) const&
+        {
+            size_type skipNumber = 0;
+            for (auto& element : _elements)
+            {
+                if (std::invoke(matchFunction, element))
+                {
+                    ++skipNumber;
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            return Skip(skipNumber);
+        }
+
+        /// Skips elements while the match function returns true and returns the remainder of the collection.
+        /// Reuses the storage of this collection, which is left in a valid but unspecified state.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns A new collection with the elements skipped until the match function returns false.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, TElement const&>
+        CLinqCollection<TElement, TAllocator> SkipWhile(TMatch&& matchFunction) &&
+        {
+            auto const firstKept = std::find_if_not(_elements.begin(), _elements.end(), [&matchFunction](TElement const& element)
+            {
+                return std::invoke(matchFunction, element);
+            });
+            _elements.erase(_elements.begin(), firstKept);
+
+            return std::move(*this);
+        }
+
+        /// Static casts each element of the collection to a new collection.
+        /// @tparam TCast The type to cast to.
+        /// @param collection The collection to cast.
+        /// @returns The casted collection.
+        template <typename TCast>
+        CLinqCollection<TCast, RebindAllocator<TCast>> StaticCast() const
+        {
+            static_assert(
+                std::is_convertible<TElement, TCast>::value,
+                "Cannot cast StaticCast CLinqCollection.");
+
+            auto newElements = std::vector<TCast, RebindAllocator<TCast>>(
+                _elements.size(),
+                RebindAllocator<TCast>(_elements.get_allocator()));
+
+            for (size_type i = 0; i < _elements.size(); ++i)
+            {
+                newElements[i] = static_cast<TCast>(_elements[i]);
+            }
+
+            return CLinqCollection<TCast, RebindAllocator<TCast>>(std::move(newElements));
+        }
+
+        /// Computes the sum of the elements in the collection.
+        /// Arithmetic elements are summed with vectorised kernels where available, so floating
+        /// point sums may differ in rounding from a sequential sum.
+        /// @returns The sum of the elements in the collection, or a value initialized element if the collection is empty.
+        TElement Sum() const
+        {
+            return AsView().Sum();
+        }
+
+        /// Computes the sum of the projections of the elements in the collection.
+        /// @tparam TProjector The type of the projection function.
+        /// @param projectionFunction The projection function.
+        /// @returns The sum of the projections of the elements in the collection.
+        template <typename TProjector>
+            requires std::invocable<TProjector&, TElement const&>
+        ProjectionResult<TProjector> Sum(TProjector&& projectionFunction) const
+        {
+            return AsView().Sum(projectionFunction);
+        }
+
+        /// Takes a specific number of elements from the start of the collection.
+        /// @param numberOfElements The number of elements to take.
+        /// @returns A new collection with the first n elements from the collection.
+        CLinqCollection<TElement, TAllocator> Take(size_type const numberOfElements) const&
+        {
+            if (numberOfElements > _elements.size())
+            {
+                throw CLinqException("Cannot take more elements than exist in collection.");
+            }
+
+            return CLinqCollection<TElement, TAllocator>(std::vector<TElement, TAllocator>(
+                _elements.begin(), _elements.begin() + numberOfElements,
+                _elements.get_allocator()));
+        }
+
+        /// Takes a specific number of elements from the start of the collection.
+        /// Reuses the storage of this collection, which is left in a valid but unspecified state.
+        /// @param numberOfElements The number of elements to take.
+        /// @returns A new collection with the first n elements from the collection.
+        CLinqCollection<TElement, TAllocator> Take(size_type const numberOfElements) &&
+        {
+            if (numberOfElements > _elements.size())
+            {
+                throw CLinqException("Cannot take more elements than exist in collection.");
+            }
+
+            _elements.erase(_elements.begin() + numberOfElements, _elements.end());
+
+            return std::move(*this);
+        }
+
+        /// Takes a specific number of elements from the end of the collection.
+        /// @param numberOfElements The number of elements to take.
+        /// @returns A new collection with the last n elements from the collection.
+        CLinqCollection<TElement, TAllocator> TakeLast(size_type const numberOfElements) const&
+        {
+            if (numberOfElements > _elements.size())
+            {
+                throw CLinqException("Cannot take more elements than exist in collection.");
+            }
+
+            return CLinqCollection<TElement, TAllocator>(std::vector<TElement, TAllocator>(
+                _elements.end() - numberOfElements, _elements.end(),
+                _elements.get_allocator()));
+        }
+
+        /// Takes a specific number of elements from the end of the collection.
+        /// Reuses the storage of this collection, which is left in a valid but unspecified state.
+        /// @param numberOfElements The number of elements to take.
+        /// @returns A new collection with the last n elements from the collection.
+        CLinqCollection<TElement, TAllocator> TakeLast(size_type const numberOfElements) &&
+        {
+            if (numberOfElements > _elements.size())
+            {
+                throw CLinqException("Cannot take more elements than exist in collection.");
+            }
+
+            _elements.erase(_elements.begin(), _elements.end() - numberOfElements);
+
+            return std::move(*this);
+        }
+
+        /// Takes elements while the match function returns true.
+        /// @param matchFunction The match function.
+        /// @returns A new collection with the elements taken until the match function returns false.
+        CLinqCollection<TElement, TAllocator> TakeWhile(MatchFunction const& matchFunction) const&
+        {
+            return TakeWhile<MatchFunction const&>(matchFunction);
+        }
+
+        /// Takes elements while the match function returns true.
+        /// Reuses the storage of this collection, which is left in a valid but unspecified state.
+        /// @param matchFunction The match function.
+        /// @returns A new collection with the elements taken until the match function returns false.
+        CLinqCollection<TElement, TAllocator> TakeWhile(MatchFunction const& matchFunction) &&
+        {
+            return std::move(*this).template TakeWhile<MatchFunction const&>(matchFunction);
+        }
+
+        /// Takes elements while the match function returns true.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns A new collection with the elements taken until the match function returns false.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, TElement const&>
+        CLinqCollection<TElement, TAllocator> TakeWhile(TMatch&& matchFunction) const&
+        {
+            auto newElements = std::vector<TElement, TAllocator>(_elements.get_allocator());
+
+            for (auto& element : _elements)
+            {
+                if (std::invoke(matchFunction, element))
+                {
+                    newElements.emplace_back(element);
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            return CLinqCollection<TElement, TAllocator>(std::move(newElements));
+        }
+
+        /// Takes elements while the match function returns true.
+        /// Reuses the storage of this collection, which is left in a valid but unspecified state.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns A new collection with the elements taken until the match function returns false.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, TElement const&>
+        CLinqCollection<TElement, TAllocator> TakeWhile(TMatch&& matchFunction) &&
+        {
+            auto const firstOmitted = std::find_if_not(_elements.begin(), _elements.end(), [&matchFunction](TElement const& element)
+            {
+                return std::invoke(matchFunction, element);
+            });
+            _elements.erase(firstOmitted, _elements.end());
+
+            return std::move(*this);
+        }
+
+        /// Takes a specific number of elements with the least keys, in ascending order of key.
+        /// Equivalent to OrderBy(keySelector).Take(numberOfElements), but only the taken elements are copied.
+        /// Taking k of n elements keeps them in a bounded heap in O(n log k) time and O(k) memory when
+        /// k is at most n / 32, otherwise every key is computed once and sorted, using O(n) extra memory.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
+        /// @param numberOfElements The number of elements to take.
+        /// @returns A new collection with the n elements with the least keys.
+        /// @throws CLinqException When more elements are requested than exist in the collection.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, TElement const&>
+        CLinqCollection<TElement, TAllocator> TopBy(TKeySelector&& keySelector, size_type const numberOfElements) const&
+        {
+            return TopByCore(_elements, keySelector, numberOfElements, false);
+        }
+
+        /// Takes a specific number of elements with the least keys, in ascending order of key.
+        /// Equivalent to OrderBy(keySelector).Take(numberOfElements), but only the taken elements are copied.
+        /// Taking k of n elements keeps them in a bounded heap in O(n log k) time and O(k) memory when
+        /// k is at most n / 32, otherwise every key is computed once and sorted, using O(n) extra memory.
+        /// The elements are moved out of this collection, which is left in a valid but unspecified state.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
+        /// @param numberOfElements The number of elements to take.
+        /// @returns A new collection with the n elements with the least keys.
+        /// @throws CLinqException When more elements are requested than exist in the collection.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, TElement const&>
+        CLinqCollection<TElement, TAllocator> TopBy(TKeySelector&& keySelector, size_type const numberOfElements) &&
+        {
+            return TopByCore(std::move(_elements), keySelector, numberOfElements, false);
+        }
+
+        /// Takes a specific number of elements with the greatest keys, in descending order of key.
+        /// Equivalent to OrderByDescending(keySelector).Take(numberOfElements), but only the taken elements are copied.
+        /// Taking k of n elements keeps them in a bounded heap in O(n log k) time and O(k) memory when
+        /// k is at most n / 32, otherwise every key is computed once and sorted, using O(n) extra memory.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
+        /// @param numberOfElements The number of elements to take.
+        /// @returns A new collection with the n elements with the greatest keys.
+        /// @throws CLinqException When more elements are requested than exist in the collection.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, TElement const&>
+        CLinqCollection<TElement, TAllocator> TopByDescending(TKeySelector&& keySelector, size_type const numberOfElements) const&
+        {
+            return TopByCore(_elements, keySelector, numberOfElements, true);
+        }
+
+        /// Takes a specific number of elements with the greatest keys, in descending order of key.
+        /// Equivalent to OrderByDescending(keySelector).Take(numberOfElements), but only the taken elements are copied.
+        /// Taking k of n elements keeps them in a bounded heap in O(n log k) time and O(k) memory when
+        /// k is at most n / 32, otherwise every key is computed once and sorted, using O(n) extra memory.
+        /// The elements are moved out of this collection, which is left in a valid but unspecified state.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
+        /// @param numberOfElements The number of elements to take.
+        /// @returns A new collection with the n elements with the greatest keys.
+        /// @throws CLinqException When more elements are requested than exist in the collection.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, TElement const&>
+        CLinqCollection<TElement, TAllocator> TopByDescending(TKeySelector&& keySelector, size_type const numberOfElements) &&
+        {
+            return TopByCore(std::move(_elements), keySelector, numberOfElements, true);
+        }
+
+        /// Gets a collection of elements from the collection that match the match function.
+        /// @param matchFunction The match function/
+        /// @returns A collection of elements from the collection that match the match function.
+        CLinqCollection<TElement, TAllocator> Where(MatchFunction const& matchFunction) const&
+        {
+            return Where<MatchFunction const&>(matchFunction);
+        }
+
+        /// Gets a collection of elements from the collection that match the match function.
+        /// Reuses the storage of this collection, which is left in a valid but unspecified state.
+        /// @param matchFunction The match function/
+        /// @returns A collection of elements from the collection that match the match function.
+        CLinqCollection<TElement, TAllocator> Where(MatchFunction const& matchFunction) &&
+        {
+            return std::move(*this).template Where<MatchFunction const&>(matchFunction);
+        }
+
+        /// Gets a collection of elements from the collection that match the match function.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns A collection of elements from the collection that match the match function.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, TElement const&>
+        CLinqCollection<TElement, TAllocator> Where(TMatch&& matchFunction) const&
+        {
+            auto newElements = std::vector<TElement, TAllocator>(_elements.get_allocator());
+
+            for (auto& element : _elements)
+            {
+                if (std::invoke(matchFunction, element))
+                {
+                    newElements.emplace_back(element);
+                }
+            }
+
+            return CLinqCollection<TElement, TAllocator>(std::move(newElements));
+        }
+
+        /// Gets a collection of elements from the collection that match the match function.
+        /// Reuses the storage of this collection, which is left in a valid but unspecified state.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns A collection of elements from the collection that match the match function.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, TElement const&>
+        CLinqCollection<TElement, TAllocator> Where(TMatch&& matchFunction) &&
+        {
+            std::erase_if(_elements, [&matchFunction](TElement const& element)
+            {
+                return !std::invoke(matchFunction, element);
+            });
+
+            return std::move(*this);
+        }
+
+        /// Gets every window of a given size over the collection, advancing by a given step, without copying
+        /// any elements. Each window is a view over the elements of the collection, so the collection must
+        /// outlive the windows and not be resized while they are in use. Only whole windows are returned.
+        /// @param windowSize The number of elements in each window.
+        /// @param step The number of elements between the starts of consecutive windows.
+        /// @returns A collection of views over the windows of the collection.
+        /// @throws CLinqException When the window size or step is 0.
+        CLinqCollection<CLinqView<TElement>, RebindAllocator<CLinqView<TElement>>> Window(
+            size_type const windowSize,
+            size_type const step = 1) const&
+        {
+            return AsView().Window(windowSize, step, RebindAllocator<CLinqView<TElement>>(_elements.get_allocator()));
+        }
+
+        /// Windowing a temporary collection would leave every window dangling.
+        CLinqCollection<CLinqView<TElement>, RebindAllocator<CLinqView<TElement>>> Window(
+            size_type const windowSize,
+            size_type const step = 1) && = delete;
+
+        /// Computes the average of every window of a given size over the collection, advancing by a given step.
+        /// Each average is updated from the previous window rather than recomputed, so the cost is linear in
+        /// the size of the collection.
+        /// @param windowSize The number of elements in each window.
+        /// @param step The number of elements between the starts of consecutive windows.
+        /// @returns The average of each whole window, in order.
+        /// @throws CLinqException When the window size or step is 0.
+        CLinqCollection<double, RebindAllocator<double>> WindowAverage(size_type const windowSize, size_type const step = 1) const
+        {
+            static_assert(std::is_arithmetic_v<TElement>, "Cannot compute WindowAverage of non-arithmetic elements.");
+
+            using TSum = std::conditional_t<std::is_integral_v<TElement> && sizeof(TElement) < sizeof(std::int64_t), std::int64_t, double>;
+
+            return CLinqCollection<double, RebindAllocator<double>>(WindowSumCore<double, TSum>(windowSize, step,
+                [windowSize](TSum const sum) { return static_cast<double>(sum) / static_cast<double>(windowSize); }));
+        }
+
+        /// Computes the greatest element of every window of a given size over the collection, advancing by a
+        /// given step. A monotonic deque of candidate elements is maintained as the window slides, so the cost
+        /// is linear in the size of the collection.
+        /// @param windowSize The number of elements in each window.
+        /// @param step The number of elements between the starts of consecutive windows.
+        /// @returns The greatest element of each whole window, in order.
+        /// @throws CLinqException When the window size or step is 0.
+        CLinqCollection<TElement, TAllocator> WindowMax(size_type const windowSize, size_type const step = 1) const
+        {
+            return WindowExtremumCore(windowSize, step, CLinqMaximum());
+        }
+
+        /// Computes the least element of every window of a given size over the collection, advancing by a
+        /// given step. A monotonic deque of candidate elements is maintained as the window slides, so the cost
+        /// is linear in the size of the collection.
+        /// @param windowSize The number of elements in each window.
+        /// @param step The number of elements between the starts of consecutive windows.
+        /// @returns The least element of each whole window, in order.
+        /// @throws CLinqException When the window size or step is 0.
+        CLinqCollection<TElement, TAllocator> WindowMin(size_type const windowSize, size_type const step = 1) const
+        {
+            return WindowExtremumCore(windowSize, step, CLinqMinimum());
+        }
+
+        /// Computes the sum of every window of a given size over the collection, advancing by a given step.
+        /// Each sum is updated from the previous window by adding the elements entering it and subtracting
+        /// those leaving it, so the cost is linear in the size of the collection. Floating point sums are
+        /// recomputed once per window length to bound the rounding error this accumulates.
+        /// @param windowSize The number of elements in each window.
+        /// @param step The number of elements between the starts of consecutive windows.
+        /// @returns The sum of each whole window, in order.
+        /// @throws CLinqException When the window size or step is 0.
+        CLinqCollection<TElement, TAllocator> WindowSum(size_type const windowSize, size_type const step = 1) const
+        {
+            return CLinqCollection<TElement, TAllocator>(WindowSumCore<TElement, TElement>(windowSize, step,
+                [](TElement const& sum) { return sum; }));
+        }
+
+        /// Computes the set union of this collection and the given collection.
+        /// @param collection The collection.
+        /// @returns The set union of this collection and the given collection.
+        CLinqCollection<TElement, TAllocator> Union(CLinqCollection<TElement, TAllocator> const& collection) const
+        {
+            auto distinctElements = CLinqHashSet<TElement, TAllocator>(_elements.size() + collection._elements.size(), _elements.get_allocator());
+
+            for (auto& element : _elements)
+            {
+                distinctElements.Insert(element);
+            }
+
+            for (auto& element : collection._elements)
+            {
+                distinctElements.Insert(element);
+            }
+
+            return CLinqCollection<TElement, TAllocator>(std::move(distinctElements).Keys());
+        }
+
+        /// Gets the elements in the collection as a vector.
+        /// @returns The elements in the collection as a vector.
+        std::vector<TElement, TAllocator> ToVector() const& noexcept
+        {
+            return _elements;
+        }
+
+        /// Moves the elements in the collection out as a vector.
+        /// @returns The elements in the collection as a vector.
+        std::vector<TElement, TAllocator> ToVector() && noexcept
+        {
+            return std::move(_elements);
+        }
+
+        /// Gets the elements in the collection as a list.
+        /// @returns The elements in the collection as a list.
+        std::list<TElement> ToList() const
+        {
+            return std::list(_elements.begin(), _elements.end());
+        }
+
+        /// Gets the elements in the collection as a set.
+        /// @returns The elements in the collection as a set.
+        std::set<TElement> ToSet() const
+        {
+            return std::set<TElement>(_elements.begin(), _elements.end());
+        }
+
+        /// Projects the collection to a flat hash map.
+        /// The map is reserved for every element up front, and its keys and values are stored in
+        /// contiguous arrays rather than one node per entry. When keys repeat, only the value of the
+        /// last element with that key is kept.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @tparam TValueSelector The type of the value selector.
+        /// @param keySelector A projection function for the keys.
+        /// @param valueSelector A projection function for the values.
+        /// @returns A flat map from the elements in the collection, with entries in order of first appearance of their key.
+        template <typename TKeySelector, typename TValueSelector>
+            requires std::invocable<TKeySelector&, TElement const&> && std::invocable<TValueSelector&, TElement const&>
+        CLinqFlatMap<ProjectionResult<TKeySelector>, ProjectionResult<TValueSelector>, RebindAllocator<ProjectionResult<TValueSelector>>> ToFlatMap(
+            TKeySelector&& keySelector,
+            TValueSelector&& valueSelector) const
+        {
+            using TValue = ProjectionResult<TValueSelector>;
+
+            auto map = CLinqFlatMap<ProjectionResult<TKeySelector>, TValue, RebindAllocator<TValue>>(
+                _elements.size(),
+                RebindAllocator<TValue>(_elements.get_allocator()));
+
+            for (auto& element : _elements)
+            {
+                map.InsertOrAssign(std::invoke(keySelector, element), std::invoke(valueSelector, element));
+            }
+
+            return map;
+        }
+
+        /// Gets the distinct elements in the collection as a CLinqHashSet, in order of first appearance.
+        /// @returns The distinct elements in the collection as a CLinqHashSet.
+        CLinqHashSet<TElement, TAllocator> ToHashSet() const
+        {
+            auto set = CLinqHashSet<TElement, TAllocator>(_elements.size(), _elements.get_allocator());
+
+            for (auto& element : _elements)
+            {
+                set.Insert(element);
+            }
+
+            return set;
+        }
+
+        /// Projects the collection to a lookup from each key to all of its elements.
+        /// Unlike ToMap, no element is discarded when keys repeat. The lookup is read-only and stores its
+        /// keys in a hash set and the elements of every group in one contiguous buffer, so it makes a
+        /// handful of allocations rather than one per entry.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector A projection function for the keys.
+        /// @returns A lookup from each key to its elements, with groups in order of first appearance of their key.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, TElement const&>
+        CLinqLookup<ProjectionResult<TKeySelector>, TElement, TAllocator> ToLookup(TKeySelector&& keySelector) const
+        {
+            return GroupBy(keySelector);
+        }
+
+        /// Projects the collection to a lookup from each key to all of its values.
+        /// Unlike ToMap, no value is discarded when keys repeat. The lookup is read-only and stores its
+        /// keys in a hash set and the values of every group in one contiguous buffer, so it makes a
+        /// handful of allocations rather than one per entry.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @tparam TValueSelector The type of the value selector.
+        /// @param keySelector A projection function for the keys.
+        /// @param valueSelector A projection function for the values.
+        /// @returns A lookup from each key to its values, with groups in order of first appearance of their key.
+        template <typename TKeySelector, typename TValueSelector>
+            requires std::invocable<TKeySelector&, TElement const&> && std::invocable<TValueSelector&, TElement const&>
+        CLinqLookup<ProjectionResult<TKeySelector>, ProjectionResult<TValueSelector>, RebindAllocator<ProjectionResult<TValueSelector>>> ToLookup(
+            TKeySelector&& keySelector,
+            TValueSelector&& valueSelector) const
+        {
+            return GroupBy(keySelector, valueSelector);
+        }
+
+        /// Projects the collection to a map.
+        /// When keys repeat, only the value of the last element with that key is kept; use ToLookup to keep every value.
+        /// @tparam TKey The type of the map's keys.
+        /// @tparam TValue The type of the map's values.
+        /// @param keySelector A projection function for the keys.
+        /// @param valueSelector A projection function for the values.
+        /// @returns A map from the elements in the collection.
+        template <typename TKey, typename TValue>
+        std::map<TKey, TValue> ToMap(
+            ProjectionFunction<TKey> const& keySelector,
+            ProjectionFunction<TValue> const& valueSelector) const
+        {
+            return ToMapCore<std::map<TKey, TValue>>(keySelector, valueSelector);
+        }
+
+        /// Projects the collection to an unordered map.
+        /// When keys repeat, only the value of the last element with that key is kept; use ToLookup to keep every value.
+        /// @tparam TKey The type of the map's keys.
+        /// @tparam TValue The type of the map's values.
+        /// @param keySelector A projection function for the keys.
+        /// @param valueSelector A projection function for the values.
+        /// @returns An unordered map from the elements in the collection.
+        template <typename TKey, typename TValue>
+        std::unordered_map<TKey, TValue> ToUnorderedMap(
+            ProjectionFunction<TKey> const& keySelector,
+            ProjectionFunction<TValue> const& valueSelector) const
+        {
+            return ToMapCore<std::unordered_map<TKey, TValue>>(keySelector, valueSelector);
+        }
+
+        /// Combines each element with the element at the same index in another collection.
+        /// The result has as many elements as the shorter collection. When both collections have the same
+        /// arithmetic element type and the result selector is std::plus<>, std::multiplies<>, CLinqMinimum or
+        /// CLinqMaximum, the elements are combined with SIMD instructions where the target supports them.
+        /// @tparam TOther The type of elements in the other collection.
+        /// @tparam TOtherAllocator The allocator of the other collection.
+        /// @tparam TResultSelector The type of the result selector.
+        /// @param collection The other collection.
+        /// @param resultSelector Combines an element with the element at the same index in the other collection.
+        /// @returns The combined elements.
+        template <typename TOther, typename TOtherAllocator, typename TResultSelector>
+            requires std::invocable<TResultSelector&, TElement const&, TOther const&>
+        auto Zip(CLinqCollection<TOther, TOtherAllocator> const& collection, TResultSelector&& resultSelector) const
+        {
+            using TResult = std::remove_cvref_t<std::invoke_result_t<TResultSelector&, TElement const&, TOther const&>>;
+
+            auto const count = std::min<size_type>(_elements.size(), collection.Count());
+            auto newElements = std::vector<TResult, RebindAllocator<TResult>>(
+                RebindAllocator<TResult>(_elements.get_allocator()));
+
+            if constexpr (std::is_same_v<TElement, TOther> && std::is_same_v<TElement, TResult> &&
+                CLinqSimd::IsVectorised<TElement, std::remove_cvref_t<TResultSelector>>)
+            {
+                newElements.resize(count);
+                CLinqSimd::Transform(_elements.data(), collection.AsView().Data(), newElements.data(), count, resultSelector);
+            }
+            else
+            {
+                newElements.reserve(count);
+
+                for (size_type i = 0; i < count; ++i)
+                {
+                    newElements.emplace_back(std::invoke(resultSelector, _elements[i], collection[i]));
+                }
+            }
+
+            return CLinqCollection<TResult, RebindAllocator<TResult>>(std::move(newElements));
+        }
+
+        /// Pairs each element with the element at the same index in another collection.
+        /// The result has as many elements as the shorter collection.
+        /// @tparam TOther The type of elements in the other collection.
+        /// @tparam TOtherAllocator The allocator of the other collection.
+        /// @param collection The other collection.
+        /// @returns Tuples of each element and the element at the same index in the other collection.
+        template <typename TOther, typename TOtherAllocator>
+        CLinqCollection<std::tuple<TElement, TOther>, RebindAllocator<std::tuple<TElement, TOther>>> Zip(
+            CLinqCollection<TOther, TOtherAllocator> const& collection) const
+        {
+            return Zip(collection, [](TElement const& element, TOther const& other)
+            {
+                return std::tuple<TElement, TOther>(element, other);
+            });
+        }
+
+    private:
+        /// TopBy uses a bounded heap when taking at most one in this many elements.
+        static constexpr size_type TopByHeapDivisor = 32;
+
+        std::vector<TElement, TAllocator> _elements;
+
+        template <typename T>
+        static bool VectorContains(std::vector<T, TAllocator> const& vector, T const& value)
+        {
+            return std::find(vector.begin(), vector.end(), value) != vector.end();
+        }
+
+        void ThrowIfOutOfRange(size_type const index) const
+        {
+            if (index >= _elements.size())
+            {
+                throw CLinqException("Index was out of range."
+                    "Attemped to access index " + std::to_string(index) +
+                    "but collection contains " + std::to_string(_elements.size()) + " elements.");
+            }
+        }
+
+        void ThrowIfEmpty() const
+        {
+            if (_elements.empty())
+            {
+                throw CLinqException("Collection is empty.");
+            }
+        }
+
+        template <typename TElements, typename TKeySelector>
+        static CLinqOrderedCollection<TElement, TAllocator> OrderByCore(
+            TElements&& elements,
+            TKeySelector& keySelector,
+            bool const descending)
+        {
+            auto newElements = std::vector<TElement, TAllocator>(elements.get_allocator());
+            newElements.reserve(elements.size());
+
+            auto tiedWithPrevious = std::vector<bool, RebindAllocator<bool>>(RebindAllocator<bool>(elements.get_allocator()));
+            tiedWithPrevious.reserve(elements.size());
+
+            CLinqSort::Sort(
+                elements.size(),
+                [&elements, &keySelector](size_type const index)
+                {
+                    return std::invoke(keySelector, std::as_const(elements[index]));
+                },
+                descending,
+                [&elements, &newElements, &tiedWithPrevious](size_type const index, bool const tied)
+                {
+                    if constexpr (std::is_lvalue_reference_v<TElements>)
+                    {
+                        newElements.emplace_back(elements[index]);
+                    }
+                    else
+                    {
+                        newElements.emplace_back(std::move(elements[index]));
+                    }
+
+                    tiedWithPrevious.push_back(tied);
+                },
+                elements.get_allocator());
+
+            return CLinqOrderedCollection<TElement, TAllocator>(std::move(newElements), std::move(tiedWithPrevious));
+        }
+
+        template <typename TValue, typename TKeySelector, typename TValueOf>
+        CLinqLookup<ProjectionResult<TKeySelector>, TValue, RebindAllocator<TValue>> GroupByCore(
+            TKeySelector& keySelector,
+            TValueOf const& valueOf) const
+        {
+            using TKey = ProjectionResult<TKeySelector>;
+            using TLookup = CLinqLookup<TKey, TValue, RebindAllocator<TValue>>;
+
+            auto const count = _elements.size();
+            auto keys = CLinqHashSet<TKey, typename TLookup::key_allocator_type>(RebindAllocator<TKey>(_elements.get_allocator()));
+            auto offsets = std::vector<size_type, RebindAllocator<size_type>>(1, 0, RebindAllocator<size_type>(_elements.get_allocator()));
+            auto groups = std::vector<size_type, RebindAllocator<size_type>>(count, RebindAllocator<size_type>(_elements.get_allocator()));
+
+            // The first pass finds the group of each element and counts the elements in each group,
+            // offset by one so the counts become the start of each group when summed.
+            for (size_type i = 0; i < count; ++i)
+            {
+                auto const [group, inserted] = keys.Insert(std::invoke(keySelector, _elements[i]));
+                if (inserted)
+                {
+                    offsets.push_back(0);
+                }
+
+                ++offsets[group + 1];
+                groups[i] = group;
+            }
+
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+            // The second pass scatters the elements into their groups. Each group's offset is used as
+            // its cursor, after which it holds the start of the following group, so the offsets are
+            // shifted back afterwards.
+            auto values = CLinqContiguousVector<TValue, RebindAllocator<TValue>>(RebindAllocator<TValue>(_elements.get_allocator()));
+
+            if constexpr (std::is_default_constructible_v<TValue> && std::is_move_assignable_v<TValue>)
+            {
+                values.resize(count);
+                for (size_type i = 0; i < count; ++i)
+                {
+                    values[offsets[groups[i]]++] = valueOf(i);
+                }
+            }
+            else
+            {
+                // Elements which cannot be assigned into place have their indices scattered instead,
+                // and are then constructed in order.
+                auto order = std::vector<size_type, RebindAllocator<size_type>>(count, RebindAllocator<size_type>(_elements.get_allocator()));
+                for (size_type i = 0; i < count; ++i)
+                {
+                    order[offsets[groups[i]]++] = i;
+                }
+
+                values.reserve(count);
+                for (auto const index : order)
+                {
+                    values.emplace_back(valueOf(index));
+                }
+            }
+
+            std::copy_backward(offsets.begin(), offsets.end() - 1, offsets.end());
+            offsets[0] = 0;
+
+            return TLookup(std::move(keys), std::move(offsets), std::move(values));
+        }
+
+        template <typename TElements, typename TKeySelector>
+        static CLinqCollection<TElement, TAllocator> TopByCore(
+            TElements&& elements,
+            TKeySelector& keySelector,
+            size_type const numberOfElements,
+            bool const descending)
+        {
+            if (numberOfElements > elements.size())
+            {
+                throw CLinqException("Cannot take more elements than exist in collection.");
+            }
+
+            using TKey = std::remove_cvref_t<std::invoke_result_t<TKeySelector&, TElement const&>>;
+
+            auto newElements = std::vector<TElement, TAllocator>(elements.get_allocator());
+            newElements.reserve(numberOfElements);
+
+            auto const take = [&elements, &newElements](size_type const index)
+            {
+                if constexpr (std::is_lvalue_reference_v<TElements>)
+                {
+                    newElements.emplace_back(elements[index]);
+                }
+                else
+                {
+                    newElements.emplace_back(std::move(elements[index]));
+                }
+            };
+
+            // A bounded heap only pays off when few elements are taken, otherwise sorting every key
+            // is faster. Either way, only the taken elements are copied.
+            if (numberOfElements > elements.size() / TopByHeapDivisor)
+            {
+                CLinqSort::Sort(
+                    elements.size(),
+                    [&elements, &keySelector](size_type const index)
+                    {
+                        return std::invoke(keySelector, std::as_const(elements[index]));
+                    },
+                    descending,
+                    [&newElements, &take, numberOfElements](size_type const index, bool)
+                    {
+                        if (newElements.size() < numberOfElements)
+                        {
+                            take(index);
+                        }
+                    },
+                    elements.get_allocator());
+
+                return CLinqCollection<TElement, TAllocator>(std::move(newElements));
+            }
+
+            auto selection = CLinqSort::Selection<TKey, size_type, RebindAllocator<size_type>>(
+                numberOfElements, descending, RebindAllocator<size_type>(elements.get_allocator()));
+
+            for (size_type i = 0; i < elements.size(); ++i)
+            {
+                selection.Offer(std::invoke(keySelector, std::as_const(elements[i])), [i]() { return i; });
+            }
+
+            for (auto const index : std::move(selection).Values())
+            {
+                take(index);
+            }
+
+            return CLinqCollection<TElement, TAllocator>(std::move(newElements));
+        }
+
+        template <typename TResult, typename TCollectionSelector, typename TResultSelector>
+        CLinqCollection<TResult, RebindAllocator<TResult>> SelectManyCore(
+            TCollectionSelector& collectionSelector,
+            TResultSelector const& resultSelector) const
+        {
+            using TInner = std::invoke_result_t<TCollectionSelector&, TElement const&>;
+
+            // Inner ranges returned by value which are not views own their elements, so when they are flattened
+            // without a result selector their elements can be moved.
+            constexpr auto movesInnerElements = !std::is_lvalue_reference_v<TInner> &&
+                !std::ranges::view<std::remove_cvref_t<TInner>> &&
+                !std::ranges::borrowed_range<TInner>;
+
+            auto newElements = std::vector<TResult, RebindAllocator<TResult>>(
+                RebindAllocator<TResult>(_elements.get_allocator()));
+
+            // Ranges referenced by the elements, and views, can be measured without copying any elements, so
+            // sizing the result up front only costs a second, cheap call of the collection selector per element.
+            if constexpr (std::ranges::sized_range<TInner> &&
+                (std::is_lvalue_reference_v<TInner> || std::ranges::view<std::remove_cvref_t<TInner>>))
+            {
+                size_type count = 0;
+                for (auto& element : _elements)
+                {
+                    count += static_cast<size_type>(std::ranges::size(std::invoke(collectionSelector, element)));
+                }
+
+                newElements.reserve(count);
+            }
+
+            for (auto& element : _elements)
+            {
+                auto&& inner = std::invoke(collectionSelector, element);
+
+                if constexpr (std::is_same_v<TResultSelector, CLinqSelectInner> && std::ranges::common_range<TInner>)
+                {
+                    if constexpr (movesInnerElements)
+                    {
+                        newElements.insert(
+                            newElements.end(),
+                            std::make_move_iterator(std::ranges::begin(inner)),
+                            std::make_move_iterator(std::ranges::end(inner)));
+                    }
+                    else
+                    {
+                        newElements.insert(newElements.end(), std::ranges::begin(inner), std::ranges::end(inner));
+                    }
+                }
+                else
+                {
+                    for (auto&& innerElement : inner)
+                    {
+                        newElements.emplace_back(std::invoke(resultSelector, element, std::forward<decltype(innerElement)>(innerElement)));
+                    }
+                }
+            }
+
+            return CLinqCollection<TResult, RebindAllocator<TResult>>(std::move(newElements));
+        }
+
+        template <typename TAccumulate, typename TAccumulator>
+        void ScanCore(
+            std::vector<TAccumulate, RebindAllocator<TAccumulate>>& results,
+            size_type const numberOfElements,
+            TAccumulate seed,
+            TAccumulator& accumulator) const
+        {
+            if constexpr (std::is_same_v<TAccumulate, TElement> &&
+                CLinqSimd::IsScanVectorised<TElement, std::remove_cvref_t<TAccumulator>>)
+            {
+                auto const offset = results.size();
+                results.resize(offset + numberOfElements);
+                CLinqSimd::InclusiveScan(_elements.data(), results.data() + offset, numberOfElements, seed, accumulator);
+            }
+            else
+            {
+                results.reserve(results.size() + numberOfElements);
+
+                for (size_type i = 0; i < numberOfElements; ++i)
+                {
+                    seed = std::invoke(accumulator, std::move(seed), _elements[i]);
+                    results.push_back(seed);
+                }
+            }
+        }
+
+        template <typename TMap, typename TKey, typename TValue>
+        TMap ToMapCore(
+            ProjectionFunction<TKey> const& keySelector,
+            ProjectionFunction<TValue> const& valueSelector) const
+        {
+            TMap map{};
+
+            if constexpr (requires { map.reserve(_elements.size()); })
+            {
+                map.reserve(_elements.size());
+            }
+
+            for (auto& element : _elements)
+            {
+                map.insert_or_assign(keySelector(element), valueSelector(element));
+            }
+
+            return map;
+        }
+
+        size_type WindowCount(size_type const windowSize, size_type const step) const
+        {
+            if (windowSize == 0 || step == 0)
+            {
+                throw CLinqException("Window size and step must be greater than 0.");
+            }
+
+            return _elements.size() < windowSize ? 0 : (_elements.size() - windowSize) / step + 1;
+        }
+
+        template <typename TResult, typename TSum, typename TProjector>
+        std::vector<TResult, RebindAllocator<TResult>> WindowSumCore(
+            size_type const windowSize,
+            size_type const step,
+            TProjector const& projectionFunction) const
+        {
+            auto const numberOfWindows = WindowCount(windowSize, step);
+            auto results = std::vector<TResult, RebindAllocator<TResult>>(RebindAllocator<TResult>(_elements.get_allocator()));
+            results.reserve(numberOfWindows);
+
+            auto const sumOf = [this](size_type const first, size_type const last)
+            {
+                auto sum = TSum{};
+                for (auto i = first; i < last; ++i)
+                {
+                    sum += static_cast<TSum>(_elements[i]);
+                }
+
+                return sum;
+            };
+
+            auto sum = TSum{};
+            size_type sinceRecomputed = 0;
+
+            for (size_type window = 0, first = 0; window < numberOfWindows; ++window, first += step)
+            {
+                auto const recompute = window == 0 || step >= windowSize ||
+                    (std::is_floating_point_v<TSum> && sinceRecomputed >= windowSize);
+
+                if (recompute)
+                {
+                    sum = sumOf(first, first + windowSize);
+                    sinceRecomputed = 0;
+                }
+                else
+                {
+                    sum -= sumOf(first - step, first);
+                    sum += sumOf(first + windowSize - step, first + windowSize);
+                }
+
+                results.push_back(projectionFunction(sum));
+                sinceRecomputed += step;
+            }
+
+            return results;
+        }
+
+        template <typename TOperation>
+        CLinqCollection<TElement, TAllocator> WindowExtremumCore(
+            size_type const windowSize,
+            size_type const step,
+            TOperation const operation) const
+        {
+            auto const numberOfWindows = WindowCount(windowSize, step);
+            auto newElements = std::vector<TElement, TAllocator>(_elements.get_allocator());
+
+            if (numberOfWindows == 0)
+            {
+                return CLinqCollection<TElement, TAllocator>(std::move(newElements));
+            }
+
+            newElements.reserve(numberOfWindows);
+
+            // The indices of the elements which may still be the extremum of a later window, in a ring buffer.
+            // Their elements are monotonic, so the front is the extremum of the current window, and there are
+            // never more than windowSize of them.
+            auto candidates = std::vector<size_type, RebindAllocator<size_type>>(
+                windowSize, RebindAllocator<size_type>(_elements.get_allocator()));
+            size_type front = 0;
+            size_type numberOfCandidates = 0;
+
+            auto const candidate = [&candidates, &front, windowSize](size_type const position) -> size_type&
+            {
+                auto const index = front + position;
+                return candidates[index >= windowSize ? index - windowSize : index];
+            };
+
+            auto windowEnd = windowSize;
+            auto const end = (numberOfWindows - 1) * step + windowSize;
+
+            for (size_type i = 0; i < end; ++i)
+            {
+                if (numberOfCandidates != 0 && candidate(0) + windowSize <= i)
+                {
+                    front = front + 1 == windowSize ? 0 : front + 1;
+                    --numberOfCandidates;
+                }
+
+                while (numberOfCandidates != 0 &&
+                    &operation(_elements[i], _elements[candidate(numberOfCandidates - 1)]) == &_elements[i])
+                {
+                    --numberOfCandidates;
+                }
+
+                candidate(numberOfCandidates++) = i;
+
+                if (i + 1 == windowEnd)
+                {
+                    newElements.push_back(_elements[candidate(0)]);
+                    windowEnd += step;
+                }
+            }
+
+            return CLinqCollection<TElement, TAllocator>(std::move(newElements));
+        }
+};
+
+/// A collection sorted by OrderBy or OrderByDescending, which can be further sorted by ThenBy and
+/// ThenByDescending. Elements whose keys compared equal in every sort so far form runs, and
+/// subsequent sorts only reorder the elements within each run.
+/// @tparam TElement The type of elements in the collection.
+/// @tparam TAllocator The allocator used for the elements of the collection.
+export template <typename TElement, typename TAllocator>
+class CLinqOrderedCollection : public CLinqCollection<TElement, TAllocator>
+{
+    public:
+        using size_type = typename CLinqCollection<TElement, TAllocator>::size_type;
+
+        /// Type alias for the allocator of the run boundaries.
+        using TiesAllocator = typename std::allocator_traits<TAllocator>::template rebind_alloc<bool>;
+
+        /// Initializes a new instance of the CLinqOrderedCollection class.
+        /// @param elements The sorted elements.
+        /// @param tiedWithPrevious For each element, whether its keys are equal to those of the element before it.
+        CLinqOrderedCollection(
+            std::vector<TElement, TAllocator>&& elements,
+            std::vector<bool, TiesAllocator>&& tiedWithPrevious) noexcept
+            : CLinqCollection<TElement, TAllocator>(std::move(elements)),
+              _tiedWithPrevious(std::move(tiedWithPrevious))
+        {
+        }
+
+        /// Stably sorts elements with equal keys in ascending order of another key.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
+        /// @returns The sorted collection.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, TElement const&>
+        CLinqOrderedCollection<TElement, TAllocator> ThenBy(TKeySelector&& keySelector) const&
+        {
+            auto ordered = *this;
+            ordered.ThenByCore(keySelector, false);
+
+            return ordered;
+        }
+
+        /// Stably sorts elements with equal keys in ascending order of another key.
+        /// Reuses the storage of this collection, which is left in a valid but unspecified state.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
+        /// @returns The sorted collection.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, TElement const&>
+        CLinqOrderedCollection<TElement, TAllocator> ThenBy(TKeySelector&& keySelector) &&
+        {
+            ThenByCore(keySelector, false);
+
+            return std::move(*this);
+        }
+
+        /// Stably sorts elements with equal keys in descending order of another key.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
+        /// @returns The sorted collection.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, TElement const&>
+        CLinqOrderedCollection<TElement, TAllocator> ThenByDescending(TKeySelector&& keySelector) const&
+        {
+            auto ordered = *this;
+            ordered.ThenByCore(keySelector, true);
+
+            return ordered;
+        }
+
+        /// Stably sorts elements with equal keys in descending order of another key.
+        /// Reuses the storage of this collection, which is left in a valid but unspecified state.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
+        /// @returns The sorted collection.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, TElement const&>
+        CLinqOrderedCollection<TElement, TAllocator> ThenByDescending(TKeySelector&& keySelector) &&
+        {
+            ThenByCore(keySelector, true);
+
+            return std::move(*this);
+        }
+
+    private:
+        std::vector<bool, TiesAllocator> _tiedWithPrevious;
+
+        template <typename TKeySelector>
+        void ThenByCore(TKeySelector& keySelector, bool const descending)
+        {
+            auto& elements = *this;
+            auto const count = _tiedWithPrevious.size();
+            auto run = std::vector<TElement, TAllocator>(this->get_allocator());
+
+            for (size_type first = 0; first < count;)
+            {
+                auto last = first + 1;
+                while (last < count && _tiedWithPrevious[last])
+                {
+                    ++last;
+                }
+
+                if (last - first > 1)
+                {
+                    run.clear();
+                    auto position = first;
+
+                    CLinqSort::Sort(
+                        last - first,
+                        [&elements, &keySelector, first](size_type const index)
+                        {
+                            return std::invoke(keySelector, std::as_const(elements[first + index]));
+                        },
+                        descending,
+                        [this, &elements, &run, &position, first](size_type const index, bool const tied)
+                        {
+                            run.emplace_back(std::move(elements[first + index]));
+                            _tiedWithPrevious[position++] = tied;
+                        },
+                        this->get_allocator());
+
+                    std::move(run.begin(), run.end(), this->begin() + first);
+                }
+
+                first = last;
+            }
+        }
+};
+
+/// A CLinqCollection whose elements, and those of every collection produced from it, are allocated from a CLinqArena.
+/// @tparam TElement The type of elements in the collection.
+export template <typename TElement>
+using CLinqArenaCollection = CLinqCollection<TElement, CLinqArenaAllocator<TElement>>;
+
+/// A non-owning, read-only view over a contiguous range of elements supporting CLinq methods.
+/// Slicing a view is O(1) and never allocates; elements are only copied when the view is
+/// converted to a collection. The viewed elements must outlive the view.
+/// @tparam TElement The type of elements in the view.
+export template <typename TElement>
+class CLinqView
+{
+    public:
+        using value_type = TElement;
+        using size_type = std::size_t;
+
+        using iterator = TElement const*;
+        using const_iterator = TElement const*;
+
+        /// Type alias for the type an element is projected to by a projection function.
+        /// @tparam TProjector The type of the projection function.
+        template <typename TProjector>
+        using ProjectionResult = std::remove_cvref_t<std::invoke_result_t<TProjector&, TElement const&>>;
+
+        /// Initializes a new instance of the CLinqView class.
+        CLinqView() noexcept
+            : _data(nullptr), _size(0)
+        {
+        }
+
+        /// Initializes a new instance of the CLinqView class.
+        /// @param data A pointer to the first element to view.
+        /// @param numberOfElements The number of elements to view.
+        CLinqView(TElement const* const data, size_type const numberOfElements) noexcept
+            : _data(data), _size(numberOfElements)
+        {
+        }
+
+        /// Gets a const reference to the element at a given index of the view.
+        /// @param i The index.
+        /// @returns A const reference to the element at a given index of the view.
+        TElement const& operator[](size_type const i) const
+        {
+            return _data[i];
+        }
+
+        /// Checks if the view contains the same elements as the given view.
+        /// @param view The view to compare to.
+        /// @returns True if the views contain equal elements, false otherwise.
+        bool operator==(CLinqView<TElement> const& view) const
+        {
+            return std::equal(begin(), end(), view.begin(), view.end());
+        }
+
+        /// Gets the iterator at the start of the view.
+        const_iterator begin() const noexcept
+        {
+            return _data;
+        }
+
+        /// Gets the iterator at the end of the view.
+        const_iterator end() const noexcept
+        {
+            return _data + _size;
+        }
+
+        /// Gets the const iterator at the start of the view.
+        const_iterator cbegin() const noexcept
+        {
+            return _data;
+        }
+
+        /// Gets the const iterator at the end of the view.
+        const_iterator cend() const noexcept
+        {
+            return _data + _size;
+        }
+
+        /// Applies an accumulator function over the elements of the view, in order, starting from a seed.
+        /// @tparam TAccumulate The type of the accumulated value.
+        /// @tparam TAccumulator The type of the accumulator function.
+        /// @param seed The initial accumulated value.
+        /// @param accumulator Combines the accumulated value with the next element.
+        /// @returns The final accumulated value.
+        template <typename TAccumulate, typename TAccumulator>
+            requires std::invocable<TAccumulator&, TAccumulate, TElement const&>
+        TAccumulate Aggregate(TAccumulate seed, TAccumulator&& accumulator) const
+        {
+            for (auto& element : *this)
+            {
+                seed = std::invoke(accumulator, std::move(seed), element);
+            }
+
+            return seed;
+        }
+
+        /// Applies an accumulator function over the elements of the view, in order, starting from a seed,
+        /// and projects the final accumulated value.
+        /// @tparam TAccumulate The type of the accumulated value.
+        /// @tparam TAccumulator The type of the accumulator function.
+        /// @tparam TResultSelector The type of the result selector.
+        /// @param seed The initial accumulated value.
+        /// @param accumulator Combines the accumulated value with the next element.
+        /// @param resultSelector Projects the final accumulated value.
+        /// @returns The projection of the final accumulated value.
+        template <typename TAccumulate, typename TAccumulator, typename TResultSelector>
+            requires std::invocable<TAccumulator&, TAccumulate, TElement const&> &&
+                std::invocable<TResultSelector&, TAccumulate>
+        auto Aggregate(TAccumulate seed, TAccumulator&& accumulator, TResultSelector&& resultSelector) const
+        {
+            return std::invoke(resultSelector, Aggregate(std::move(seed), accumulator));
+        }
+
+        /// Checks that every element in the view matches the given match function.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns True if every element in the view matches the given match function, false otherwise.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, TElement const&>
+        bool All(TMatch&& matchFunction) const
+        {
+            return AsQuery().All(matchFunction);
+        }
+
+        /// Checks if the view contains any element.
+        /// @returns True if the view contains any element, false otherwise.
+        bool Any() const noexcept
+        {
+            return _size != 0;
+        }
+
+        /// Splits the view into contiguous chunks of a given size. Every chunk is a view over
+        /// the same elements, so no elements are copied. The last chunk holds the remainder
+        /// and may be smaller.
+        /// @tparam TAllocator The allocator of the resulting collection.
+        /// @param chunkSize The number of elements in each chunk.
+        /// @param allocator The allocator.
+        /// @returns A collection of views over consecutive chunks of the view.
+        /// @throws CLinqException When the chunk size is 0.
+        template <typename TAllocator = std::allocator<CLinqView<TElement>>>
+        CLinqCollection<CLinqView<TElement>, TAllocator> Chunk(size_type const chunkSize, TAllocator const& allocator = TAllocator()) const
+        {
+            if (chunkSize == 0)
+            {
+                throw CLinqException("Chunk size must be greater than 0.");
+            }
+
+            auto chunks = std::vector<CLinqView<TElement>, TAllocator>(allocator);
+            chunks.reserve(_size / chunkSize + (_size % chunkSize != 0));
+
+            for (size_type offset = 0; offset < _size; offset += chunkSize)
+            {
+                chunks.emplace_back(_data + offset, std::min(chunkSize, _size - offset));
+            }
+
+            return CLinqCollection<CLinqView<TElement>, TAllocator>(std::move(chunks));
+        }
+
+        /// Checks if the view contains any element that matches the given function.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns True if the view contains any element that matches the given function, false otherwise.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, TElement const&>
+        bool Any(TMatch&& matchFunction) const
+        {
+            return AsQuery().Any(matchFunction);
+        }
+
+        /// Gets a lazily evaluated query over the elements of the view.
+        /// @returns A lazily evaluated query over the elements of the view.
+        CLinqQuery<CLinqIteratorEnumerator<const_iterator>> AsQuery() const noexcept
+        {
+            return CLinqQuery<CLinqIteratorEnumerator<const_iterator>>(CLinqIteratorEnumerator<const_iterator>(begin(), end()));
+        }
+
+        /// Gets a const reference to the element at given index in the view.
+        /// @param index The index.
+        /// @returns A const reference to the element at given index in the view.
+        /// @throws CLinqException When the index is out of range.
+        TElement const& At(size_type const index) const
+        {
+            ThrowIfEmpty();
+            ThrowIfOutOfRange(index);
+
+            return _data[index];
+        }
+
+        /// Computes the average of the elements in the view.
+        /// Integers are summed in 64 bits and floats in double, with the vectorised CLinqSimd::Reduce kernel where there is one.
+        /// @returns The average of the elements in the view.
+        /// @throws CLinqException When the view is empty.
+        double Average() const
+        {
+            static_assert(std::is_arithmetic_v<TElement>, "Cannot compute Average of non-arithmetic elements.");
+            ThrowIfEmpty();
+
+            if constexpr (std::is_same_v<TElement, double>)
+            {
+                return Sum() / static_cast<double>(_size);
+            }
+            else if constexpr (std::is_same_v<TElement, float>)
+            {
+                return CLinqSimd::Reduce<double>(_data, _size, std::plus<>()) / static_cast<double>(_size);
+            }
+            else if constexpr (std::is_integral_v<TElement>)
+            {
+                using TSum = std::conditional_t<std::is_unsigned_v<TElement> && sizeof(TElement) == sizeof(std::int64_t), std::uint64_t, std::int64_t>;
+
+                if constexpr (CLinqSimd::IsReduceVectorised<TSum, TElement, std::plus<>>)
+                {
+                    return static_cast<double>(CLinqSimd::Reduce<TSum>(_data, _size, std::plus<>())) / static_cast<double>(_size);
+                }
+                else
+                {
+                    // Without lanes to widen the elements into, a plain loop is left for the compiler to vectorise.
+                    TSum total = 0;
+                    for (auto& element : *this)
+                    {
+                        total += element;
+                    }
+
+                    return static_cast<double>(total) / static_cast<double>(_size);
+                }
+            }
+            else
+            {
+                return Average([](TElement const& element) { return element; });
+            }
+        }
+
+        /// Computes the average of the projections of the elements in the view.
+        /// @tparam TProjector The type of the projection function.
+        /// @param projectionFunction The projection function.
+        /// @returns The average of the projections of the elements in the view.
+        /// @throws CLinqException When the view is empty.
+        template <typename TProjector>
+            requires std::invocable<TProjector&, TElement const&>
+        double Average(TProjector&& projectionFunction) const
+        {
+            ThrowIfEmpty();
+
+            double total = 0;
+            for (auto& element : *this)
+            {
+                total += static_cast<double>(std::invoke(projectionFunction, element));
+            }
+
+            return total / static_cast<double>(_size);
+        }
+
+        /// Checks whether or not the view contains the given element.
+        /// @param element The element to find.
+        /// @returns True if the view contains the given element, false otherwise.
+        bool Contains(TElement const& element) const
+        {
+            return std::find(begin(), end(), element) != end();
+        }
+
+        /// Gets the number of elements in the view.
+        /// @returns The number of elements in the view.
+        size_type Count() const noexcept
+        {
+            return _size;
+        }
+
+        /// Gets the number of elements in the view that match the given match function.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns The number of elements that match the given match function.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, TElement const&>
+        size_type Count(TMatch&& matchFunction) const
+        {
+            return AsQuery().Count(matchFunction);
+        }
+
+        /// Gets a pointer to the first element in the view.
+        /// @returns A pointer to the first element in the view.
+        TElement const* Data() const noexcept
+        {
+            return _data;
+        }
+
+        /// Gets a const reference to the first element in the view.
+        /// @returns A const reference to the first element in the view.
+        /// @throws CLinqException When the view is empty.
+        TElement const& First() const
+        {
+            ThrowIfEmpty();
+
+            return _data[0];
+        }
+
+        /// Gets a const reference to the last element in the view.
+        /// @returns A const reference to the last element in the view.
+        /// @throws CLinqException When the view is empty.
+        TElement const& Last() const
+        {
+            ThrowIfEmpty();
+
+            return _data[_size - 1];
+        }
+
+        /// Gets the greatest element in the view.
+        /// @returns The greatest element in the view.
+        /// @throws CLinqException When the view is empty.
+        TElement Max() const
+        {
+            ThrowIfEmpty();
+
+            return CLinqSimd::Reduce(_data, _size, CLinqMaximum{});
+        }
+
+        /// Gets the greatest projection of the elements in the view.
+        /// @tparam TProjector The type of the projection function.
+        /// @param projectionFunction The projection function.
+        /// @returns The greatest projection of the elements in the view.
+        /// @throws CLinqException When the view is empty.
+        template <typename TProjector>
+            requires std::invocable<TProjector&, TElement const&>
+        ProjectionResult<TProjector> Max(TProjector&& projectionFunction) const
+        {
+            ThrowIfEmpty();
+
+            auto result = std::invoke(projectionFunction, _data[0]);
+            for (size_type i = 1; i < _size; ++i)
+            {
+                auto projection = std::invoke(projectionFunction, _data[i]);
+                if (result < projection)
+                {
+                    result = std::move(projection);
+                }
+            }
+
+            return result;
+        }
+
+        /// Gets the first element in the view with the greatest key.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
+        /// @returns A const reference to the first element in the view with the greatest key.
+        /// @throws CLinqException When the view is empty.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, TElement const&>
+        TElement const& MaxBy(TKeySelector&& keySelector) const
+        {
+            ThrowIfEmpty();
+
+            size_type resultIndex = 0;
+            auto resultKey = std::invoke(keySelector, _data[0]);
+            for (size_type i = 1; i < _size; ++i)
+            {
+                auto key = std::invoke(keySelector, _data[i]);
+                if (resultKey < key)
+                {
+                    resultIndex = i;
+                    resultKey = std::move(key);
+                }
+            }
+
+            return _data[resultIndex];
+        }
+
+        /// Gets the least element in the view.
+        /// @returns The least element in the view.
+        /// @throws CLinqException When the view is empty.
+        TElement Min() const
+        {
+            ThrowIfEmpty();
+
+            return CLinqSimd::Reduce(_data, _size, CLinqMinimum{});
+        }
+
+        /// Gets the least projection of the elements in the view.
+        /// @tparam TProjector The type of the projection function.
+        /// @param projectionFunction The projection function.
+        /// @returns The least projection of the elements in the view.
+        /// @throws CLinqException When the view is empty.
+        template <typename TProjector>
+            requires std::invocable<TProjector&, TElement const&>
+        ProjectionResult<TProjector> Min(TProjector&& projectionFunction) const
+        {
+            ThrowIfEmpty();
+
+            auto result = std::invoke(projectionFunction, _data[0]);
+            for (size_type i = 1; i < _size; ++i)
+            {
+                auto projection = std::invoke(projectionFunction, _data[i]);
+                if (projection < result)
+                {
+                    result = std::move(projection);
+                }
+            }
+
+            return result;
+        }
+
+        /// Gets the first element in the view with the least key.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
+        /// @returns A const reference to the first element in the view with the least key.
+        /// @throws CLinqException When the view is empty.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, TElement const&>
+        TElement const& MinBy(TKeySelector&& keySelector) const
+        {
+            ThrowIfEmpty();
+
+            size_type resultIndex = 0;
+            auto resultKey = std::invoke(keySelector, _data[0]);
+            for (size_type i = 1; i < _size; ++i)
+            {
+                auto key = std::invoke(keySelector, _data[i]);
+                if (key < resultKey)
+                {
+                    resultIndex = i;
+                    resultKey = std::move(key);
+                }
+            }
+
+            return _data[resultIndex];
+        }
+
+        /// Projects each element to a new collection using the projection function.
+        /// @tparam TProjector The type of the projection function.
+        /// @param projectionFunction The projection function.
+        /// @returns Each element projected into a new collection.
+        template <typename TProjector>
+            requires std::invocable<TProjector&, TElement const&>
+        auto Select(TProjector&& projectionFunction) const
+        {
+            return AsQuery().Select(std::forward<TProjector>(projectionFunction)).ToCollection();
+        }
+
+        /// Returns the only element of the view.
+        /// @returns A reference to the single element of the view.
+        /// @throws CLinqException If 0 or many elements are contained within the view.
+        TElement const& Single() const
+        {
+            ThrowIfEmpty();
+            if (_size > 1)
+            {
+                throw CLinqException("Collection contains more than 1 element.");
+            }
+
+            return _data[0];
+        }
+
+        /// Skips a given number of elements and returns a view of the rest.
+        /// @param numberOfElements The number of elements to skip.
+        /// @returns A view of the remainder of the elements after skipping n.
+        CLinqView<TElement> Skip(size_type const numberOfElements) const
+        {
+            if (numberOfElements > _size)
+            {
+                throw CLinqException("Cannot skip more elements than exist in collection.");
+            }
+
+            return CLinqView<TElement>(_data + numberOfElements, _size - numberOfElements);
+        }
+
+        /// Skips a given number of elements from the back of the view and returns a view of the rest.
+        /// @param numberOfElements The number of elements to skip from the back.
+        /// @returns A view of the remainder of the elements after skipping n from the back.
+        CLinqView<TElement> SkipLast(size_type const numberOfElements) const
+        {
+            if (numberOfElements > _size)
+            {
+                throw CLinqException("Cannot skip more elements than exist in collection.");
+            }
+
+            return CLinqView<TElement>(_data, _size - numberOfElements);
+        }
+
+        /// Skips elements while the match function returns true and returns a view of the rest.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns A view of the elements after the match function first returns false.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, TElement const&>
+        CLinqView<TElement> SkipWhile(TMatch&& matchFunction) const
+        {
+            auto const firstKept = std::find_if_not(begin(), end(), [&matchFunction](TElement const& element)
+            {
+                return std::invoke(matchFunction, element);
+            });
+
+            return CLinqView<TElement>(firstKept, static_cast<size_type>(end() - firstKept));
+        }
+
+        /// Computes the sum of the elements in the view.
+        /// Arithmetic elements are summed with vectorised kernels where available, so floating
+        /// point sums may differ in rounding from a sequential sum.
+        /// @returns The sum of the elements in the view, or a value initialized element if the view is empty.
+        TElement Sum() const
+        {
+            if (_size == 0)
+            {
+                return TElement{};
+            }
+
+            return CLinqSimd::Reduce(_data, _size, std::plus<>{});
+        }
+
+        /// Computes the sum of the projections of the elements in the view.
+        /// @tparam TProjector The type of the projection function.
+        /// @param projectionFunction The projection function.
+        /// @returns The sum of the projections of the elements in the view.
+        template <typename TProjector>
+            requires std::invocable<TProjector&, TElement const&>
+        ProjectionResult<TProjector> Sum(TProjector&& projectionFunction) const
+        {
+            auto total = ProjectionResult<TProjector>{};
+            for (auto& element : *this)
+            {
+                total += std::invoke(projectionFunction, element);
+            }
+
+            return total;
+        }
+
+        /// Takes a view of a specific number of elements from the start of the view.
+        /// @param numberOfElements The number of elements to take.
+        /// @returns A view of the first n elements.
+        CLinqView<TElement> Take(size_type const numberOfElements) const
+        {
+            if (numberOfElements > _size)
+            {
+                throw CLinqException("Cannot take more elements than exist in collection.");
+            }
+
+            return CLinqView<TElement>(_data, numberOfElements);
+        }
+
+        /// Takes a view of a specific number of elements from the end of the view.
+        /// @param numberOfElements The number of elements to take.
+        /// @returns A view of the last n elements.
+        CLinqView<TElement> TakeLast(size_type const numberOfElements) const
+        {
+            if (numberOfElements > _size)
+            {
+                throw CLinqException("Cannot take more elements than exist in collection.");
+            }
+
+            return CLinqView<TElement>(end() - numberOfElements, numberOfElements);
+        }
+
+        /// Takes a view of the elements while the match function returns true.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns A view of the elements until the match function first returns false.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, TElement const&>
+        CLinqView<TElement> TakeWhile(TMatch&& matchFunction) const
+        {
+            auto const firstOmitted = std::find_if_not(begin(), end(), [&matchFunction](TElement const& element)
+            {
+                return std::invoke(matchFunction, element);
+            });
+
+            return CLinqView<TElement>(_data, static_cast<size_type>(firstOmitted - begin()));
+        }
+
+        /// Gets a collection of elements from the view that match the match function.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns A collection of elements from the view that match the match function.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, TElement const&>
+        CLinqCollection<TElement> Where(TMatch&& matchFunction) const
+        {
+            return AsQuery().Where(std::forward<TMatch>(matchFunction)).ToCollection();
+        }
+
+        /// Gets every window of a given size over the view, advancing by a given step. Every window
+        /// is a view over the same elements, so no elements are copied. Only whole windows are returned.
+        /// @tparam TAllocator The allocator of the resulting collection.
+        /// @param windowSize The number of elements in each window.
+        /// @param step The number of elements between the starts of consecutive windows.
+        /// @param allocator The allocator.
+        /// @returns A collection of views over the windows of the view.
+        /// @throws CLinqException When the window size or step is 0.
+        template <typename TAllocator = std::allocator<CLinqView<TElement>>>
+        CLinqCollection<CLinqView<TElement>, TAllocator> Window(
+            size_type const windowSize,
+            size_type const step = 1,
+            TAllocator const& allocator = TAllocator()) const
+        {
+            if (windowSize == 0 || step == 0)
+            {
+                throw CLinqException("Window size and step must be greater than 0.");
+            }
+
+            auto windows = std::vector<CLinqView<TElement>, TAllocator>(allocator);
+
+            if (_size >= windowSize)
+            {
+                auto const numberOfWindows = (_size - windowSize) / step + 1;
+                windows.reserve(numberOfWindows);
+
+                for (size_type window = 0; window < numberOfWindows; ++window)
+                {
+                    windows.emplace_back(_data + window * step, windowSize);
+                }
+            }
+
+            return CLinqCollection<CLinqView<TElement>, TAllocator>(std::move(windows));
+        }
+
+        /// Copies the elements in the view to a collection.
+        /// @tparam TAllocator The allocator of the collection.
+        /// @param allocator The allocator.
+        /// @returns A collection containing the elements in the view.
+        template <typename TAllocator = std::allocator<TElement>>
+        CLinqCollection<TElement, TAllocator> ToCollection(TAllocator const& allocator = TAllocator()) const
+        {
+            return CLinqCollection<TElement, TAllocator>(ToVector(allocator));
+        }
+
+        /// Copies the elements in the view to a vector.
+        /// @tparam TAllocator The allocator of the vector.
+        /// @param allocator The allocator.
+        /// @returns A vector containing the elements in the view.
+        template <typename TAllocator = std::allocator<TElement>>
+        std::vector<TElement, TAllocator> ToVector(TAllocator const& allocator = TAllocator()) const
+        {
+            return std::vector<TElement, TAllocator>(begin(), end(), allocator);
+        }
+
+    private:
+        TElement const* _data;
+        size_type _size;
+
+        void ThrowIfOutOfRange(size_type const index) const
+        {
+            if (index >= _size)
+            {
+                throw CLinqException("Index was out of range."
+                    "Attempted to access index " + std::to_string(index) +
+                    "but collection contains " + std::to_string(_size) + " elements.");
+            }
+        }
+
+        void ThrowIfEmpty() const
+        {
+            if (_size == 0)
+            {
+                throw CLinqException("Collection is empty.");
+            }
+        }
+};
+
+/// A group of elements sharing a key, viewing the elements of a CLinqLookup.
+/// The lookup must outlive the grouping.
+/// @tparam TKey The type of the key.
+/// @tparam TElement The type of elements in the group.
+export template <typename TKey, typename TElement>
+class CLinqGrouping : public CLinqView<TElement>
+{
+    public:
+        /// Initializes a new instance of the CLinqGrouping class.
+        /// @param key The key of the group.
+        /// @param elements The elements in the group.
+        CLinqGrouping(TKey const& key, CLinqView<TElement> const elements) noexcept
+            : CLinqView<TElement>(elements), _key(&key)
+        {
+        }
+
+        /// Gets the key of the group.
+        /// @returns The key of the group.
+        TKey const& Key() const noexcept
+        {
+            return *_key;
+        }
+
+    private:
+        TKey const* _key;
+};
+
+/// An immutable mapping from keys to groups of elements, as produced by GroupBy.
+/// The elements of every group are stored in one contiguous buffer, group after group, with
+/// the offset at which each group starts. Keys are hashed, so looking up a group is O(1).
+/// Groups are ordered by the first appearance of their key, and elements within a group keep
+/// their original order. Bool elements are stored one per byte, so that their groups can be viewed.
+/// @tparam TKey The type of keys.
+/// @tparam TElement The type of elements.
+/// @tparam TAllocator The type of allocator for the elements.
+export template <typename TKey, typename TElement, typename TAllocator = std::allocator<TElement>>
+class CLinqLookup
+{
+    public:
+        using key_type = TKey;
+        using value_type = CLinqGrouping<TKey, TElement>;
+        using size_type = std::size_t;
+        using allocator_type = TAllocator;
+        using key_allocator_type = typename std::allocator_traits<TAllocator>::template rebind_alloc<TKey>;
+        using offset_allocator_type = typename std::allocator_traits<TAllocator>::template rebind_alloc<size_type>;
+
+        /// Iterates the groups of a lookup.
+        class const_iterator
+        {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = CLinqGrouping<TKey, TElement>;
+                using difference_type = std::ptrdiff_t;
+                using pointer = void;
+                using reference = CLinqGrouping<TKey, TElement>;
+
+                /// Initializes a new instance of the const_iterator class.
+                const_iterator() noexcept
+                    : _lookup(nullptr), _index(0)
+                {
+                }
+
+                /// Initializes a new instance of the const_iterator class.
+                /// @param lookup The lookup.
+                /// @param index The index of the group.
+                const_iterator(CLinqLookup const* const lookup, size_type const index) noexcept
+                    : _lookup(lookup), _index(index)
+                {
+                }
+
+                /// Gets the group the iterator is positioned on.
+                /// @returns The group the iterator is positioned on.
+                reference operator*() const
+                {
+                    return _lookup->GroupAt(_index);
+                }
+
+                /// Advances the iterator to the next group.
+                /// @returns This iterator.
+                const_iterator& operator++() noexcept
+                {
+                    ++_index;
+
+                    return *this;
+                }
+
+                /// Advances the iterator to the next group.
+                /// @returns A copy of the iterator before it was advanced.
+                const_iterator operator++(int) noexcept
+                {
+                    auto const copy = *this;
+                    ++_index;
+
+                    return copy;
+                }
+
+                /// Checks if the iterator is positioned on the same group as the given iterator.
+                /// @param iterator The iterator to compare to.
+                /// @returns True if the iterators are equal, false otherwise.
+                bool operator==(const_iterator const& iterator) const noexcept
+                {
+                    return _index == iterator._index;
+                }
+
+            private:
+                CLinqLookup const* _lookup;
+                size_type _index;
+        };
+
+        using iterator = const_iterator;
+
+        /// Initializes a new instance of the CLinqLookup class.
+        /// @param keys The keys of the groups, in order of group.
+        /// @param offsets The offset of the first element of each group, followed by the number of elements.
+        /// @param elements The elements of every group, group after group.
+        CLinqLookup(
+            CLinqHashSet<TKey, key_allocator_type>&& keys,
+            std::vector<size_type, offset_allocator_type>&& offsets,
+            CLinqContiguousVector<TElement, TAllocator>&& elements) noexcept
+            : _keys(std::move(keys)), _offsets(std::move(offsets)), _elements(std::move(elements))
+        {
+        }
+
+        /// Gets the elements with the given key.
+        /// @param key The key.
+        /// @returns A view over the elements with the key, which is empty if no element has the key.
+        CLinqView<TElement> operator[](TKey const& key) const
+        {
+            auto const index = _keys.IndexOf(key);
+
+            return index == _keys.npos ? CLinqView<TElement>() : GroupAt(index);
+        }
+
+        /// Gets the allocator of the elements.
+        /// @returns The allocator of the elements.
+        allocator_type get_allocator() const noexcept
+        {
+            return _elements.get_allocator();
+        }
+
+        /// Gets the iterator at the first group.
+        const_iterator begin() const noexcept
+        {
+            return const_iterator(this, 0);
+        }
+
+        /// Gets the iterator after the last group.
+        const_iterator end() const noexcept
+        {
+            return const_iterator(this, Count());
+        }
+
+        /// Gets the const iterator at the first group.
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        /// Gets the const iterator after the last group.
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        /// Gets the group at the given index.
+        /// @param index The index of the group.
+        /// @returns The group at the given index.
+        /// @throws CLinqException When the index is out of range.
+        CLinqGrouping<TKey, TElement> At(size_type const index) const
+        {
+            if (index >= Count())
+            {
+                throw CLinqException("Index was out of range. "
+                    "Attempted to access group " + std::to_string(index) +
+                    " but lookup contains " + std::to_string(Count()) + " groups.");
+            }
+
+            return GroupAt(index);
+        }
+
+        /// Checks whether or not any element has the given key.
+        /// @param key The key.
+        /// @returns True if the lookup contains a group with the key, false otherwise.
+        bool Contains(TKey const& key) const
+        {
+            return _keys.Contains(key);
+        }
+
+        /// Gets the number of groups in the lookup.
+        /// @returns The number of groups in the lookup.
+        size_type Count() const noexcept
+        {
+            return _keys.Count();
+        }
+
+        /// Gets the elements of every group, group after group.
+        /// @returns A view over the elements of every group.
+        CLinqView<TElement> Elements() const noexcept
+        {
+            return CLinqView<TElement>(_elements.data(), _elements.size());
+        }
+
+        /// Gets the keys of the groups, in order of group.
+        /// @returns The keys of the groups.
+        std::vector<TKey, key_allocator_type> const& Keys() const noexcept
+        {
+            return _keys.Keys();
+        }
+
+    private:
+        CLinqHashSet<TKey, key_allocator_type> _keys;
+        std::vector<size_type, offset_allocator_type> _offsets;
+        CLinqContiguousVector<TElement, TAllocator> _elements;
+
+        CLinqGrouping<TKey, TElement> GroupAt(size_type const index) const noexcept
+        {
+            return CLinqGrouping<TKey, TElement>(
+                _keys.Keys()[index],
+                CLinqView<TElement>(_elements.data() + _offsets[index], _offsets[index + 1] - _offsets[index]));
+        }
+};
+
+/// How the elements of a CLinqMappedFile are expected to be read, used as a paging hint.
+export enum class CLinqAccessPattern
+{
+    /// No particular order.
+    Normal,
+
+    /// In order from first to last, so pages can be read ahead aggressively and dropped once read.
+    Sequential,
+
+    /// In no predictable order, so reading ahead would be wasted.
+    Random
+};
+
+/// A read-only view over the elements stored in a file, which is memory mapped rather than read.
+/// Pages are loaded by the operating system as they are touched, so opening a file is O(1) and
+/// its elements are never copied unless the view is converted to a collection. Views and queries
+/// produced from the mapped file must not outlive it.
+/// @tparam TElement The type of elements in the file, which are read with their in-memory representation.
+export template <typename TElement>
+    requires std::is_trivially_copyable_v<TElement>
+class CLinqMappedFile : public CLinqView<TElement>
+{
+    public:
+        /// Initializes a new instance of the CLinqMappedFile class.
+        /// @param path The path of the file.
+        /// @param accessPattern How the elements are expected to be read.
+        /// @throws CLinqException If the file cannot be mapped or its size is not a multiple of the element size.
+        explicit CLinqMappedFile(std::string const& path, CLinqAccessPattern const accessPattern = CLinqAccessPattern::Sequential)
+            : _mapping(nullptr), _mappedBytes(0)
+        {
+            Map(path);
+            static_cast<CLinqView<TElement>&>(*this) = CLinqView<TElement>(
+                static_cast<TElement const*>(_mapping),
+                _mappedBytes / sizeof(TElement));
+            Advise(accessPattern);
+        }
+
+        CLinqMappedFile(CLinqMappedFile const&) = delete;
+        CLinqMappedFile& operator=(CLinqMappedFile const&) = delete;
+
+        /// Initializes a new instance of the CLinqMappedFile class.
+        /// @param mappedFile The mapped file to take ownership of the mapping from, which is left empty.
+        CLinqMappedFile(CLinqMappedFile&& mappedFile) noexcept
+            : CLinqView<TElement>(mappedFile),
+              _mapping(std::exchange(mappedFile._mapping, nullptr)),
+              _mappedBytes(std::exchange(mappedFile._mappedBytes, 0))
+        {
+            static_cast<CLinqView<TElement>&>(mappedFile) = CLinqView<TElement>();
+        }
+
+        /// Takes ownership of the mapping of another mapped file, unmapping this one.
+        /// @param mappedFile The mapped file to take ownership of the mapping from, which is left empty.
+        /// @returns This mapped file.
+        CLinqMappedFile& operator=(CLinqMappedFile&& mappedFile) noexcept
+        {
+            if (this != &mappedFile)
+            {
+                Unmap();
+                static_cast<CLinqView<TElement>&>(*this) = mappedFile;
+                static_cast<CLinqView<TElement>&>(mappedFile) = CLinqView<TElement>();
+                _mapping = std::exchange(mappedFile._mapping, nullptr);
+                _mappedBytes = std::exchange(mappedFile._mappedBytes, 0);
+            }
+
+            return *this;
+        }
+
+        /// Unmaps the file.
+        ~CLinqMappedFile()
+        {
+            Unmap();
+        }
+
+        /// Hints to the operating system how the elements will be read from now on.
+        /// The hint is ignored where the platform does not support it.
+        /// @param accessPattern How the elements are expected to be read.
+        void Advise(CLinqAccessPattern const accessPattern) const noexcept
+        {
+#if !defined(_WIN32)
+            if (_mapping == nullptr)
+            {
+                return;
+            }
+
+            auto const advice = accessPattern == CLinqAccessPattern::Sequential ? MADV_SEQUENTIAL
+                : accessPattern == CLinqAccessPattern::Random ? MADV_RANDOM
+                : MADV_NORMAL;
+
+            ::madvise(_mapping, _mappedBytes, advice);
+#else
+            static_cast<void>(accessPattern);
+#endif
+        }
+
+    private:
+        void* _mapping;
+        std::size_t _mappedBytes;
+
+        void Map(std::string const& path)
+        {
+#if defined(_WIN32)
+            auto const file = ::CreateFileA(
+                path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                ThrowLastError("Could not open file " + path);
+            }
+
+            LARGE_INTEGER fileSize;
+            if (!::GetFileSizeEx(file, &fileSize))
+            {
+                ::CloseHandle(file);
+                ThrowLastError("Could not get the size of file " + path);
+            }
+
+            auto const bytes = static_cast<std::size_t>(fileSize.QuadPart);
+            if (bytes % sizeof(TElement) != 0)
+            {
+                ::CloseHandle(file);
+                ThrowPartialElement(path, bytes);
+            }
+
+            if (bytes != 0)
+            {
+                auto const mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                ::CloseHandle(file);
+                if (mapping == nullptr)
+                {
+                    ThrowLastError("Could not map file " + path);
+                }
+
+                _mapping = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                ::CloseHandle(mapping);
+                if (_mapping == nullptr)
+                {
+                    ThrowLastError("Could not map file " + path);
+                }
+            }
+            else
+            {
+                ::CloseHandle(file);
+            }
+#else
+            auto const file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (file == -1)
+            {
+                ThrowLastError("Could not open file " + path);
+            }
+
+            struct stat status;
+            if (::fstat(file, &status) != 0)
+            {
+                ::close(file);
+                ThrowLastError("Could not get the size of file " + path);
+            }
+
+            auto const bytes = static_cast<std::size_t>(status.st_size);
+            if (bytes % sizeof(TElement) != 0)
+            {
+                ::close(file);
+                ThrowPartialElement(path, bytes);
+            }
+
+            if (bytes != 0)
+            {
+                auto* const mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, file, 0);
+                ::close(file);
+                if (mapping == MAP_FAILED)
+                {
+                    ThrowLastError("Could not map file " + path);
+                }
+
+                _mapping = mapping;
+            }
+            else
+            {
+                ::close(file);
+            }
+#endif
+
+            _mappedBytes = bytes;
+        }
+
+        void Unmap() noexcept
+        {
+            if (_mapping != nullptr)
+            {
+#if defined(_WIN32)
+                ::UnmapViewOfFile(_mapping);
+#else
+                ::munmap(_mapping, _mappedBytes);
+#endif
+            }
+
+            _mapping = nullptr;
+            _mappedBytes = 0;
+        }
+
+        [[noreturn]] static void ThrowPartialElement(std::string const& path, std::size_t const bytes)
+        {
+            throw CLinqException("File " + path + " contains " + std::to_string(bytes) +
+                " bytes, which is not a multiple of the element size " + std::to_string(sizeof(TElement)) + ".");
+        }
+
+        [[noreturn]] static void ThrowLastError(std::string const& message)
+        {
+#if defined(_WIN32)
+            auto const error = std::error_code(static_cast<int>(::GetLastError()), std::system_category());
+#else
+            auto const error = std::error_code(errno, std::generic_category());
+#endif
+
+            throw CLinqException(message + ": " + error.message() + ".");
+        }
+};
+
+/// A fixed set of worker threads which run batches of indexed tasks, such as the chunks of a
+/// CLinqParallelCollection operator. The thread calling Run also runs tasks of its own batch, so a
+/// batch always makes progress even when every worker is busy, including when Run is called from
+/// inside a task.
+export class CLinqThreadPool final
+{
+    public:
+        using size_type = std::size_t;
+
+        /// Initializes a new instance of the CLinqThreadPool class.
+        /// @param numberOfThreads The number of worker threads, in addition to the threads calling Run.
+        explicit CLinqThreadPool(size_type const numberOfThreads)
+        {
+            _threads.reserve(numberOfThreads);
+
+            try
+            {
+                for (size_type i = 0; i < numberOfThreads; ++i)
+                {
+                    _threads.emplace_back([this] { Work(); });
+                }
+            }
+            catch (...)
+            {
+                Stop();
+                throw;
+            }
+        }
+
+        CLinqThreadPool(CLinqThreadPool const&) = delete;
+        CLinqThreadPool& operator=(CLinqThreadPool const&) = delete;
+
+        /// Finishes the batches in progress and joins the worker threads.
+        ~CLinqThreadPool()
+        {
+            Stop();
+        }
+
+        /// Gets the pool shared by every CLinqParallelCollection, with one worker thread fewer than the
+        /// number of hardware threads. The workers are started the first time the pool is used.
+        /// @returns The shared pool.
+        static CLinqThreadPool& Default()
+        {
+            static CLinqThreadPool pool(std::max<size_type>(std::thread::hardware_concurrency(), 1) - 1);
+
+            return pool;
+        }
+
+        /// Gets the number of worker threads.
+        /// @returns The number of worker threads.
+        size_type ThreadCount() const noexcept
+        {
+            return _threads.size();
+        }
+
+        /// Calls a function with every index of a batch, concurrently, and waits for every call to return.
+        /// If any call throws, the remaining calls still run and the exception of the lowest index is rethrown.
+        /// @tparam TFunction The type of the function.
+        /// @param numberOfTasks The number of indices.
+        /// @param function The function, which must be safe to call concurrently.
+        template <typename TFunction>
+            requires std::invocable<TFunction const&, size_type>
+        void Run(size_type const numberOfTasks, TFunction const& function)
+        {
+            auto batch = Batch(numberOfTasks, &function, [](void const* const function, size_type const index)
+            {
+                (*static_cast<TFunction const*>(function))(index);
+            });
+
+            auto const shared = numberOfTasks > 1 && !_threads.empty();
+
+            if (shared)
+            {
+                {
+                    auto const lock = std::lock_guard(_mutex);
+                    _batches.push_back(&batch);
+                }
+
+                _workAvailable.notify_all();
+            }
+
+            batch.Work();
+
+            if (shared)
+            {
+                // Once the batch is out of the queue no worker can start on it, so it is finished when
+                // every worker which started on it has left.
+                auto lock = std::unique_lock(_mutex);
+                std::erase(_batches, &batch);
+                _batchLeft.wait(lock, [&batch] { return batch.workers == 0; });
+            }
+
+            for (auto& error : batch.errors)
+            {
+                if (error)
+                {
+                    std::rethrow_exception(error);
+                }
+            }
+        }
+
+    private:
+        struct Batch
+        {
+            Batch(size_type const numberOfTasks, void const* const function, void (*const invoke)(void const*, size_type))
+                : numberOfTasks(numberOfTasks), function(function), invoke(invoke), next(0), workers(0), errors(numberOfTasks)
+            {
+            }
+
+            void Work() noexcept
+            {
+                for (auto index = next.fetch_add(1, std::memory_order_relaxed);
+                    index < numberOfTasks;
+                    index = next.fetch_add(1, std::memory_order_relaxed))
+                {
+                    try
+                    {
+                        invoke(function, index);
+                    }
+                    catch (...)
+                    {
+                        errors[index] = std::current_exception();
+                    }
+                }
+            }
+
+            size_type const numberOfTasks;
+            void const* const function;
+            void (*const invoke)(void const*, size_type);
+            std::atomic<size_type> next;
+            size_type workers;
+            std::vector<std::exception_ptr> errors;
+        };
+
+        std::mutex _mutex;
+        std::condition_variable _workAvailable;
+        std::condition_variable _batchLeft;
+        std::vector<Batch*> _batches;
+        bool _stopping = false;
+        std::vector<std::jthread> _threads;
+
+        void Work()
+        {
+            auto lock = std::unique_lock(_mutex);
+
+            while (true)
+            {
+                _workAvailable.wait(lock, [this] { return _stopping || !_batches.empty(); });
+
+                if (_batches.empty())
+                {
+                    return;
+                }
+
+                auto* const batch = _batches.front();
+                ++batch->workers;
+
+                lock.unlock();
+                batch->Work();
+                lock.lock();
+
+                // Every task of the batch has been claimed, so no other worker needs to start on it.
+                std::erase(_batches, batch);
+                --batch->workers;
+                _batchLeft.notify_all();
+            }
+        }
+
+        void Stop() noexcept
+        {
+            {
+                auto const lock = std::lock_guard(_mutex);
+                _stopping = true;
+            }
+
+            _workAvailable.notify_all();
+            _threads.clear();
+        }
+};
+
+/// A collection of elements whose CLinq methods are evaluated across multiple threads.
+/// The elements are split into contiguous chunks which are processed concurrently and results
+/// are combined in the original order. Chunks are run on CLinqThreadPool::Default(), so no more
+/// chunks run at once than it has workers, plus the calling thread. Match and projection functions
+/// must be safe to call concurrently.
+/// @tparam TElement The type of elements in the collection.
+export template <typename TElement>
+class CLinqParallelCollection
+{
+    static_assert(!std::is_same_v<TElement, bool>,
+        "CLinqParallelCollection cannot hold bool elements, as std::vector<bool> does not store them contiguously. "
+        "Project to char or std::uint8_t instead.");
+
+    public:
+        using value_type = TElement;
+        using size_type = std::size_t;
+
+        /// Initializes a new instance of the CLinqParallelCollection class over borrowed elements.
+        /// @param elements A view of the elements, which must outlive the collection.
+        /// @param degreeOfParallelism The maximum number of threads to use.
+        CLinqParallelCollection(CLinqView<TElement> const elements, size_type const degreeOfParallelism) noexcept
+            : _storage(), _elements(elements), _degreeOfParallelism(std::max<size_type>(degreeOfParallelism, 1))
+        {
+        }
+
+        /// Initializes a new instance of the CLinqParallelCollection class which owns its elements.
+        /// @tparam TAllocator The allocator of the elements.
+        /// @param elements The elements, which are moved into the collection.
+        /// @param degreeOfParallelism The maximum number of threads to use.
+        template <typename TAllocator>
+        CLinqParallelCollection(std::vector<TElement, TAllocator>&& elements, size_type const degreeOfParallelism)
+            : CLinqParallelCollection(
+                std::make_shared<std::vector<TElement, TAllocator> const>(std::move(elements)),
+                degreeOfParallelism)
+        {
+        }
+
+        /// Gets the default maximum number of threads to use, the number of hardware threads.
+        /// @returns The default maximum number of threads to use.
+        static size_type DefaultDegreeOfParallelism() noexcept
+        {
+            return std::max<size_type>(std::thread::hardware_concurrency(), 1);
+        }
+
+        /// Gets the maximum number of threads used by the collection.
+        /// @returns The maximum number of threads used by the collection.
+        size_type DegreeOfParallelism() const noexcept
+        {
+            return _degreeOfParallelism;
+        }
+
+        /// Gets the collection with a different maximum number of threads.
+        /// @param degreeOfParallelism The maximum number of threads to use.
+        /// @returns The collection with the given maximum number of threads.
+        CLinqParallelCollection<TElement> WithDegreeOfParallelism(size_type const degreeOfParallelism) const
+        {
+            auto collection = *this;
+            collection._degreeOfParallelism = std::max<size_type>(degreeOfParallelism, 1);
+
+            return collection;
+        }
+
+        /// Applies an accumulator function over the elements of the collection in parallel.
+        /// Each thread accumulates a contiguous chunk of elements starting from a copy of the seed, then
+        /// the results of the chunks are combined pairwise in a tree, in order, one level at a time. The
+        /// seed must be an identity of the combiner and the combiner must be associative, but it need not
+        /// be commutative.
+        /// @tparam TAccumulate The type of the accumulated value.
+        /// @tparam TAccumulator The type of the accumulator function.
+        /// @tparam TCombiner The type of the combiner.
+        /// @param seed The initial accumulated value of each chunk.
+        /// @param accumulator Combines the accumulated value with the next element.
+        /// @param combiner Combines the accumulated values of two adjacent runs of elements.
+        /// @returns The final accumulated value.
+        template <typename TAccumulate, typename TAccumulator, typename TCombiner>
+            requires std::invocable<TAccumulator&, TAccumulate, TElement const&> &&
+                std::invocable<TCombiner&, TAccumulate, TAccumulate>
+        TAccumulate Aggregate(TAccumulate const& seed, TAccumulator&& accumulator, TCombiner&& combiner) const
+        {
+            auto const chunkCount = ChunkCount();
+            auto results = std::vector<std::optional<TAccumulate>>(chunkCount);
+
+            ForEachChunk([&seed, &accumulator, &results](size_type const chunkIndex, CLinqView<TElement> const chunk)
+            {
+                results[chunkIndex].emplace(chunk.Aggregate(seed, accumulator));
+            });
+
+            // Each level of the tree combines the result at every even multiple of twice the stride with
+            // the result one stride after it, as its own batch so that no task waits on another.
+            for (size_type stride = 1; stride < chunkCount; stride *= 2)
+            {
+                auto const pairCount = (chunkCount - stride + stride * 2 - 1) / (stride * 2);
+
+                CLinqThreadPool::Default().Run(pairCount, [&combiner, &results, stride](size_type const pairIndex)
+                {
+                    auto const chunkIndex = pairIndex * stride * 2;
+                    *results[chunkIndex] = std::invoke(combiner, std::move(*results[chunkIndex]), std::move(*results[chunkIndex + stride]));
+                });
+            }
+
+            return std::move(*results[0]);
+        }
+
+        /// Applies an accumulator function over the elements of the collection in parallel, and projects
+        /// the final accumulated value. See Aggregate(seed, accumulator, combiner) for how chunks are combined.
+        /// @tparam TAccumulate The type of the accumulated value.
+        /// @tparam TAccumulator The type of the accumulator function.
+        /// @tparam TCombiner The type of the combiner.
+        /// @tparam TResultSelector The type of the result selector.
+        /// @param seed The initial accumulated value of each chunk.
+        /// @param accumulator Combines the accumulated value with the next element.
+        /// @param combiner Combines the accumulated values of two adjacent runs of elements.
+        /// @param resultSelector Projects the final accumulated value.
+        /// @returns The projection of the final accumulated value.
+        template <typename TAccumulate, typename TAccumulator, typename TCombiner, typename TResultSelector>
+            requires std::invocable<TAccumulator&, TAccumulate, TElement const&> &&
+                std::invocable<TCombiner&, TAccumulate, TAccumulate> &&
+                std::invocable<TResultSelector&, TAccumulate>
+        auto Aggregate(
+            TAccumulate const& seed,
+            TAccumulator&& accumulator,
+            TCombiner&& combiner,
+            TResultSelector&& resultSelector) const
+        {
+            return std::invoke(resultSelector, Aggregate(seed, accumulator, combiner));
+        }
+
+        /// Checks that every element in the collection matches the given match function.
+        /// Threads stop early once a non-matching element is found.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns True if every element in the collection matches the given match function, false otherwise.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, TElement const&>
+        bool All(TMatch&& matchFunction) const
+        {
+            return !Any([&matchFunction](TElement const& element) { return !std::invoke(matchFunction, element); });
+        }
+
+        /// Checks if the collection contains any element that matches the given function.
+        /// Threads stop early once a matching element is found.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns True if the collection contains any element that matches the given function, false otherwise.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, TElement const&>
+        bool Any(TMatch&& matchFunction) const
+        {
+            auto found = std::atomic<bool>(false);
+
+            ForEachChunk([&matchFunction, &found](size_type, CLinqView<TElement> const chunk)
+            {
+                for (auto& element : chunk)
+                {
+                    if (found.load(std::memory_order_relaxed))
+                    {
+                        return;
+                    }
+
+                    if (std::invoke(matchFunction, element))
+                    {
+                        found.store(true, std::memory_order_relaxed);
+                        return;
+                    }
+                }
+            });
+
+            return found.load();
+        }
+
+        /// Gets the number of elements in the collection.
+        /// @returns The number of elements in the collection.
+        size_type Count() const noexcept
+        {
+            return _elements.Count();
+        }
+
+        /// Gets the number of elements in the collection that match the given match function.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns The number of elements that match the given match function.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, TElement const&>
+        size_type Count(TMatch&& matchFunction) const
+        {
+            auto counts = std::vector<size_type>(ChunkCount());
+
+            ForEachChunk([&matchFunction, &counts](size_type const chunkIndex, CLinqView<TElement> const chunk)
+            {
+                counts[chunkIndex] = chunk.Count(matchFunction);
+            });
+
+            return std::accumulate(counts.begin(), counts.end(), size_type{ 0 });
+        }
+
+        /// Gets the distinct elements of the collection, in order of first appearance.
+        /// Each chunk is made distinct concurrently before the chunks are merged in order.
+        /// @returns The distinct elements of the collection.
+        CLinqParallelCollection<TElement> Distinct() const
+        {
+            return MergeDistinct(DistinctChunks(_elements), {});
+        }
+
+        /// Computes the running results of an accumulator function over the elements of the collection in
+        /// parallel, starting from a seed, excluding the element at each index. The first result is the seed.
+        /// Works in two passes like Scan, so the accumulator must be associative, but it need not be commutative.
+        /// @tparam TAccumulator The type of the accumulator function.
+        /// @param seed The first result.
+        /// @param accumulator Combines two adjacent running results.
+        /// @returns The running results, one for each element.
+        template <typename TAccumulator>
+            requires std::invocable<TAccumulator&, TElement const&, TElement const&>
+        CLinqParallelCollection<TElement> ExclusiveScan(TElement const& seed, TAccumulator&& accumulator) const
+        {
+            auto results = std::vector<TElement>(_elements.Count());
+
+            if (!results.empty())
+            {
+                results[0] = seed;
+                ScanCore(_elements.SkipLast(1), results.data() + 1, seed, accumulator);
+            }
+
+            return CLinqParallelCollection<TElement>(std::move(results), _degreeOfParallelism);
+        }
+
+        /// Gets the elements in this collection with elements in the given collection omitted.
+        /// @tparam TAllocator The allocator of the given collection.
+        /// @param collection The collection.
+        /// @returns The elements in this collection with elements in the given collection omitted.
+        template <typename TAllocator>
+        CLinqParallelCollection<TElement> Except(CLinqCollection<TElement, TAllocator> const& collection) const
+        {
+            auto const omittedElements = collection.ToHashSet();
+
+            return Where([&omittedElements](TElement const& element) { return !omittedElements.Contains(element); });
+        }
+
+        /// Computes the set intersection of this collection and the given collection.
+        /// @tparam TAllocator The allocator of the given collection.
+        /// @param collection The collection.
+        /// @returns The set intersection of this collection and the given collection.
+        template <typename TAllocator>
+        CLinqParallelCollection<TElement> Intersection(CLinqCollection<TElement, TAllocator> const& collection) const
+        {
+            auto const intersectingElements = collection.ToHashSet();
+
+            return Where([&intersectingElements](TElement const& element) { return intersectingElements.Contains(element); });
+        }
+
+        /// Computes the running results of an accumulator function over the elements of the collection in
+        /// parallel, starting from a seed. The first pass reduces the elements of each chunk concurrently,
+        /// the totals of the chunks are then combined in order starting from the seed, and the second pass
+        /// scans each chunk concurrently starting from the total of the chunks before it. The accumulator
+        /// must be associative, but it need not be commutative. Sums of arithmetic elements are computed
+        /// with vectorised kernels where available, so floating point sums may differ in rounding from a
+        /// sequential scan.
+        /// @tparam TAccumulator The type of the accumulator function.
+        /// @param seed The value preceding the first result.
+        /// @param accumulator Combines two adjacent running results.
+        /// @returns The running results, one for each element.
+        template <typename TAccumulator>
+            requires std::invocable<TAccumulator&, TElement const&, TElement const&>
+        CLinqParallelCollection<TElement> Scan(TElement const& seed, TAccumulator&& accumulator) const
+        {
+            auto results = std::vector<TElement>(_elements.Count());
+            ScanCore(_elements, results.data(), seed, accumulator);
+
+            return CLinqParallelCollection<TElement>(std::move(results), _degreeOfParallelism);
+        }
+
+        /// Projects each element to a new collection using the projection function.
+        /// The projected type must be default constructible, as each thread writes its projections in place.
+        /// @tparam TProjection The type to project the elements to. Defaults to the result type of the projection function.
+        /// @tparam TProjector The type of the projection function.
+        /// @param projectionFunction The projection function.
+        /// @returns Each element projected into a new collection.
+        template <typename TProjection = void, typename TProjector>
+            requires std::invocable<TProjector&, TElement const&>
+        auto Select(TProjector&& projectionFunction) const
+        {
+            using TResult = std::conditional_t<
+                std::is_void_v<TProjection>,
+                std::remove_cvref_t<std::invoke_result_t<TProjector&, TElement const&>>,
+                TProjection>;
+
+            auto newElements = std::vector<TResult>(_elements.Count());
+            auto const* const first = _elements.Data();
+
+            ForEachChunk([&projectionFunction, &newElements, first](size_type, CLinqView<TElement> const chunk)
+            {
+                auto output = newElements.begin() + (chunk.Data() - first);
+                for (auto& element : chunk)
+                {
+                    *output = std::invoke(projectionFunction, element);
+                    ++output;
+                }
+            });
+
+            return CLinqParallelCollection<TResult>(std::move(newElements), _degreeOfParallelism);
+        }
+
+        /// Static casts each element of the collection to a new collection.
+        /// @tparam TCast The type to cast to.
+        /// @returns The cast collection.
+        template <typename TCast>
+        CLinqParallelCollection<TCast> StaticCast() const
+        {
+            static_assert(
+                std::is_convertible<TElement, TCast>::value,
+                "Cannot cast StaticCast CLinqParallelCollection.");
+
+            return Select<TCast>([](TElement const& element) { return static_cast<TCast>(element); });
+        }
+
+        /// Computes the set union of this collection and the given collection.
+        /// @tparam TAllocator The allocator of the given collection.
+        /// @param collection The collection.
+        /// @returns The set union of this collection and the given collection.
+        template <typename TAllocator>
+        CLinqParallelCollection<TElement> Union(CLinqCollection<TElement, TAllocator> const& collection) const
+        {
+            return MergeDistinct(DistinctChunks(_elements), DistinctChunks(collection.AsView()));
+        }
+
+        /// Gets a collection of elements from the collection that match the match function.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns A collection of elements from the collection that match the match function.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, TElement const&>
+        CLinqParallelCollection<TElement> Where(TMatch&& matchFunction) const
+        {
+            auto chunkElements = std::vector<std::vector<TElement>>(ChunkCount());
+
+            ForEachChunk([&matchFunction, &chunkElements](size_type const chunkIndex, CLinqView<TElement> const chunk)
+            {
+                for (auto& element : chunk)
+                {
+                    if (std::invoke(matchFunction, element))
+                    {
+                        chunkElements[chunkIndex].emplace_back(element);
+                    }
+                }
+            });
+
+            return CLinqParallelCollection<TElement>(Concatenate(std::move(chunkElements)), _degreeOfParallelism);
+        }
+
+        /// Gets the elements in the collection as a sequential collection.
+        /// @returns The elements in the collection as a sequential collection.
+        CLinqCollection<TElement> ToCollection() const
+        {
+            return CLinqCollection<TElement>(ToVector());
+        }
+
+        /// Gets the elements in the collection as a vector.
+        /// @returns The elements in the collection as a vector.
+        std::vector<TElement> ToVector() const
+        {
+            return _elements.ToVector();
+        }
+
+    private:
+        static constexpr size_type MinimumChunkSize = 1024;
+
+        std::shared_ptr<void const> _storage;
+        CLinqView<TElement> _elements;
+        size_type _degreeOfParallelism;
+
+        template <typename TAllocator>
+        CLinqParallelCollection(
+            std::shared_ptr<std::vector<TElement, TAllocator> const> const& storage,
+            size_type const degreeOfParallelism)
+            : _storage(storage),
+              _elements(storage->data(), storage->size()),
+              _degreeOfParallelism(std::max<size_type>(degreeOfParallelism, 1))
+        {
+        }
+
+        size_type ChunkCount() const noexcept
+        {
+            return ChunkCount(_elements.Count());
+        }
+
+        size_type ChunkCount(size_type const numberOfElements) const noexcept
+        {
+            auto const chunksOfMinimumSize = (numberOfElements + MinimumChunkSize - 1) / MinimumChunkSize;
+
+            return std::max<size_type>(std::min(_degreeOfParallelism, chunksOfMinimumSize), 1);
+        }
+
+        template <typename TFunction>
+        void ForEachChunk(TFunction const& function) const
+        {
+            ForEachChunk(_elements, function);
+        }
+
+        template <typename TFunction>
+        void ForEachChunk(CLinqView<TElement> const elements, TFunction const& function) const
+        {
+            auto const chunkCount = ChunkCount(elements.Count());
+
+            CLinqThreadPool::Default().Run(chunkCount, [&elements, &function, chunkCount](size_type const chunkIndex)
+            {
+                auto const begin = elements.Count() * chunkIndex / chunkCount;
+                auto const end = elements.Count() * (chunkIndex + 1) / chunkCount;
+
+                function(chunkIndex, CLinqView<TElement>(elements.Data() + begin, end - begin));
+            });
+        }
+
+        template <typename TAccumulator>
+        void ScanCore(
+            CLinqView<TElement> const elements,
+            TElement* const results,
+            TElement const& seed,
+            TAccumulator const& accumulator) const
+        {
+            auto const chunkCount = ChunkCount(elements.Count());
+            auto totals = std::vector<TElement>(chunkCount, seed);
+
+            if (chunkCount > 1)
+            {
+                ForEachChunk(elements, [&accumulator, &totals, chunkCount](size_type const chunkIndex, CLinqView<TElement> const chunk)
+                {
+                    if (chunkIndex + 1 < chunkCount)
+                    {
+                        totals[chunkIndex + 1] = CLinqSimd::Reduce(chunk.Data(), chunk.Count(), accumulator);
+                    }
+                });
+
+                for (size_type chunkIndex = 1; chunkIndex < chunkCount; ++chunkIndex)
+                {
+                    totals[chunkIndex] = static_cast<TElement>(std::invoke(accumulator, totals[chunkIndex - 1], totals[chunkIndex]));
+                }
+            }
+
+            ForEachChunk(elements, [&accumulator, &totals, &elements, results](size_type const chunkIndex, CLinqView<TElement> const chunk)
+            {
+                CLinqSimd::InclusiveScan(
+                    chunk.Data(),
+                    results + (chunk.Data() - elements.Data()),
+                    chunk.Count(),
+                    totals[chunkIndex],
+                    accumulator);
+            });
+        }
+
+        std::vector<CLinqHashSet<TElement>> DistinctChunks(CLinqView<TElement> const elements) const
+        {
+            auto chunkElements = std::vector<CLinqHashSet<TElement>>(ChunkCount(elements.Count()));
+
+            ForEachChunk(elements, [&chunkElements](size_type const chunkIndex, CLinqView<TElement> const chunk)
+            {
+                for (auto& element : chunk)
+                {
+                    chunkElements[chunkIndex].Insert(element);
+                }
+            });
+
+            return chunkElements;
+        }
+
+        CLinqParallelCollection<TElement> MergeDistinct(
+            std::vector<CLinqHashSet<TElement>>&& firstChunks,
+            std::vector<CLinqHashSet<TElement>>&& secondChunks) const
+        {
+            auto distinctElements = CLinqHashSet<TElement>();
+
+            for (auto* chunks : { &firstChunks, &secondChunks })
+            {
+                for (auto& chunk : *chunks)
+                {
+                    for (auto& element : std::move(chunk).Keys())
+                    {
+                        distinctElements.Insert(std::move(element));
+                    }
+                }
+            }
+
+            return CLinqParallelCollection<TElement>(std::move(distinctElements).Keys(), _degreeOfParallelism);
+        }
+
+        static std::vector<TElement> Concatenate(std::vector<std::vector<TElement>>&& chunkElements)
+        {
+            size_type numberOfElements = 0;
+            for (auto& chunk : chunkElements)
+            {
+                numberOfElements += chunk.size();
+            }
+
+            auto elements = std::vector<TElement>();
+            elements.reserve(numberOfElements);
+
+            for (auto& chunk : chunkElements)
+            {
+                elements.insert(elements.end(), std::make_move_iterator(chunk.begin()), std::make_move_iterator(chunk.end()));
+            }
+
+            return elements;
+        }
+};
+
+/// Enumerates the elements in an iterator range.
+/// @tparam TIterator The type of iterator.
+export template <typename TIterator>
+class CLinqIteratorEnumerator
+{
+    public:
+        using value_type = typename std::iterator_traits<TIterator>::value_type;
+
+        /// Initializes a new instance of the CLinqIteratorEnumerator class.
+        /// @param begin The iterator at the start of the range.
+        /// @param end The iterator at the end of the range.
+        CLinqIteratorEnumerator(TIterator begin, TIterator end) noexcept
+            : _current(begin), _next(begin), _end(end)
+        {
+        }
+
+        /// Advances the enumerator to the next element.
+        /// @returns True if the enumerator was advanced, false if the end of the range was reached.
+        bool MoveNext()
+        {
+            if (_next == _end)
+            {
+                return false;
+            }
+
+            _current = _next;
+            ++_next;
+
+            return true;
+        }
+
+        /// Gets the element the enumerator is positioned on.
+        /// @returns The element the enumerator is positioned on.
+        decltype(auto) Current() const
+        {
+            return *_current;
+        }
+
+    private:
+        TIterator _current;
+        TIterator _next;
+        TIterator _end;
+};
+
+/// A sequence of values produced on demand by a coroutine, which runs until its next co_yield each
+/// time the generator is advanced. The coroutine does not start until the first value is requested
+/// and exceptions it throws are rethrown to the caller. A generator can only be iterated once.
+/// @tparam T The type of values produced.
+export template <typename T>
+class CLinqGenerator
+{
+    public:
+        using value_type = T;
+
+        /// The promise type of coroutines returning a CLinqGenerator.
+        class promise_type
+        {
+            public:
+                /// Creates the generator returned from the coroutine.
+                /// @returns The generator.
+                CLinqGenerator get_return_object() noexcept
+                {
+                    return CLinqGenerator(std::coroutine_handle<promise_type>::from_promise(*this));
+                }
+
+                /// Suspends the coroutine before its body runs.
+                /// @returns An awaitable which always suspends.
+                std::suspend_always initial_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                /// Suspends the coroutine once it has finished so the generator can observe that it is done.
+                /// @returns An awaitable which always suspends.
+                std::suspend_always final_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                /// Suspends the coroutine at a co_yield. The yielded value lives until the coroutine is resumed.
+                /// @param value The yielded value.
+                /// @returns An awaitable which always suspends.
+                std::suspend_always yield_value(T const& value) noexcept
+                {
+                    _current = std::addressof(value);
+                    return {};
+                }
+
+                /// Completes the coroutine.
+                void return_void() const noexcept
+                {
+                }
+
+                /// Stores an exception thrown by the coroutine so it can be rethrown to the caller.
+                void unhandled_exception() noexcept
+                {
+                    _exception = std::current_exception();
+                }
+
+                /// Generators only suspend at co_yield.
+                template <typename TAwaitable>
+                std::suspend_never await_transform(TAwaitable&&) = delete;
+
+                /// Gets the last yielded value.
+                /// @returns The last yielded value.
+                T const& Current() const noexcept
+                {
+                    return *_current;
+                }
+
+                /// Rethrows the exception thrown by the coroutine, if any.
+                void RethrowIfFailed() const
+                {
+                    if (_exception)
+                    {
+                        std::rethrow_exception(_exception);
+                    }
+                }
+
+            private:
+                T const* _current = nullptr;
+                std::exception_ptr _exception;
+        };
+
+        /// Iterates the values of a generator.
+        class iterator
+        {
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+
+                /// Initializes a new instance of the iterator class.
+                iterator() noexcept
+                    : _generator(nullptr)
+                {
+                }
+
+                /// Initializes a new instance of the iterator class.
+                /// @param generator The generator, which has been advanced to its first value.
+                explicit iterator(CLinqGenerator* const generator) noexcept
+                    : _generator(generator)
+                {
+                }
+
+                /// Gets the value the iterator is positioned on.
+                /// @returns The value the iterator is positioned on.
+                T const& operator*() const noexcept
+                {
+                    return _generator->Current();
+                }
+
+                /// Advances the generator to its next value.
+                /// @returns This iterator.
+                iterator& operator++()
+                {
+                    _generator->MoveNext();
+                    return *this;
+                }
+
+                /// Advances the generator to its next value.
+                void operator++(int)
+                {
+                    ++*this;
+                }
+
+                /// Checks whether or not the generator has finished.
+                /// @returns True if the generator has finished, false otherwise.
+                bool operator==(std::default_sentinel_t) const noexcept
+                {
+                    return _generator == nullptr || _generator->_coroutine.done();
+                }
+
+            private:
+                CLinqGenerator* _generator;
+        };
+
+        /// Initializes a new instance of the CLinqGenerator class.
+        /// @param coroutine The coroutine producing the values.
+        explicit CLinqGenerator(std::coroutine_handle<promise_type> const coroutine) noexcept
+            : _coroutine(coroutine)
+        {
+        }
+
+        CLinqGenerator(CLinqGenerator const&) = delete;
+        CLinqGenerator& operator=(CLinqGenerator const&) = delete;
+
+        /// Initializes a new instance of the CLinqGenerator class.
+        /// @param generator The generator to take the coroutine from, which is left empty.
+        CLinqGenerator(CLinqGenerator&& generator) noexcept
+            : _coroutine(std::exchange(generator._coroutine, nullptr))
+        {
+        }
+
+        /// Takes the coroutine of another generator, destroying this one's.
+        /// @param generator The generator to take the coroutine from, which is left empty.
+        /// @returns This generator.
+        CLinqGenerator& operator=(CLinqGenerator&& generator) noexcept
+        {
+            if (this != &generator)
+            {
+                Destroy();
+                _coroutine = std::exchange(generator._coroutine, nullptr);
+            }
+
+            return *this;
+        }
+
+        /// Destroys the coroutine.
+        ~CLinqGenerator()
+        {
+            Destroy();
+        }
+
+        /// Runs the coroutine until it yields its first value.
+        /// @returns An iterator positioned on the first value.
+        iterator begin()
+        {
+            MoveNext();
+            return iterator(this);
+        }
+
+        /// Gets the sentinel marking the end of the values.
+        /// @returns The sentinel marking the end of the values.
+        std::default_sentinel_t end() const noexcept
+        {
+            return {};
+        }
+
+        /// Runs the coroutine until it yields its next value.
+        /// @returns True if a value was yielded, false if the coroutine has finished.
+        /// @throws Any exception thrown by the coroutine.
+        bool MoveNext()
+        {
+            if (!_coroutine || _coroutine.done())
+            {
+                return false;
+            }
+
+            _coroutine.resume();
+            if (_coroutine.done())
+            {
+                _coroutine.promise().RethrowIfFailed();
+                return false;
+            }
+
+            return true;
+        }
+
+        /// Gets the value the generator last yielded.
+        /// @returns The value the generator last yielded.
+        T const& Current() const noexcept
+        {
+            return _coroutine.promise().Current();
+        }
+
+    private:
+        std::coroutine_handle<promise_type> _coroutine;
+
+        void Destroy() noexcept
+        {
+            if (_coroutine)
+            {
+                _coroutine.destroy();
+                _coroutine = nullptr;
+            }
+        }
+};
+
+/// Enumerates the values of a generator. Copies of the enumerator share the generator, so a query
+/// over a generator consumes it and can only be evaluated once.
+/// @tparam T The type of values produced by the generator.
+export template <typename T>
+class CLinqGeneratorEnumerator
+{
+    public:
+        using value_type = T;
+
+        /// Initializes a new instance of the CLinqGeneratorEnumerator class.
+        /// @param generator The generator.
+        explicit CLinqGeneratorEnumerator(CLinqGenerator<T>&& generator)
+            : _generator(std::make_shared<CLinqGenerator<T>>(std::move(generator)))
+        {
+        }
+
+        /// Advances the enumerator to the next value.
+        /// @returns True if the enumerator was advanced, false if the generator has finished.
+        bool MoveNext()
+        {
+            return _generator->MoveNext();
+        }
+
+        /// Gets the value the enumerator is positioned on.
+        /// @returns The value the enumerator is positioned on.
+        T const& Current() const noexcept
+        {
+            return _generator->Current();
+        }
+
+    private:
+        std::shared_ptr<CLinqGenerator<T>> _generator;
+};
+
+/// Enumerates values starting from an initial value and prefix incrementing it, without storing them.
+/// @tparam T The type of values.
+export template <typename T>
+class CLinqRangeEnumerator
+{
+    public:
+        using value_type = T;
+
+        /// Initializes a new instance of the CLinqRangeEnumerator class.
+        /// @param initial The initial value.
+        /// @param count The number of values.
+        CLinqRangeEnumerator(T initial, std::size_t const count)
+            : _current(std::move(initial)), _remaining(count), _started(false)
+        {
+        }
+
+        /// Advances the enumerator to the next value.
+        /// @returns True if the enumerator was advanced, false if every value has been enumerated.
+        bool MoveNext()
+        {
+            if (_remaining == 0)
+            {
+                return false;
+            }
+
+            if (_started)
+            {
+                ++_current;
+            }
+
+            _started = true;
+            --_remaining;
+
+            return true;
+        }
+
+        /// Gets the value the enumerator is positioned on.
+        /// @returns The value the enumerator is positioned on.
+        T const& Current() const noexcept
+        {
+            return _current;
+        }
+
+    private:
+        T _current;
+        std::size_t _remaining;
+        bool _started;
+};
+
+/// Enumerates the same value a number of times, without storing the copies.
+/// @tparam T The type of the value.
+export template <typename T>
+class CLinqRepeatEnumerator
+{
+    public:
+        using value_type = T;
+
+        /// Initializes a new instance of the CLinqRepeatEnumerator class.
+        /// @param element The value.
+        /// @param count The number of times to enumerate the value.
+        CLinqRepeatEnumerator(T element, std::size_t const count)
+            : _element(std::move(element)), _remaining(count)
+        {
+        }
+
+        /// Advances the enumerator to the next repetition.
+        /// @returns True if the enumerator was advanced, false if every repetition has been enumerated.
+        bool MoveNext() noexcept
+        {
+            if (_remaining == 0)
+            {
+                return false;
+            }
+
+            --_remaining;
+
+            return true;
+        }
+
+        /// Gets the value.
+        /// @returns The value.
+        T const& Current() const noexcept
+        {
+            return _element;
+        }
+
+    private:
+        T _element;
+        std::size_t _remaining;
+};
+
+/// Enumerates the lines of a stream or file, reading it in fixed size chunks so that only one chunk
+/// and the current line are held in memory however large the input is. Line endings, including a
+/// carriage return before the line feed, are not part of the lines.
+/// Nothing is read until the first call to MoveNext. A file is opened by each enumerator which starts
+/// reading it, so queries over a file can be evaluated repeatedly, whereas queries over a stream
+/// consume it and can only be evaluated once. Copies of an enumerator which has started reading
+/// share its position.
+export class CLinqLineEnumerator
+{
+    public:
+        using value_type = std::string;
+
+        /// Initializes a new instance of the CLinqLineEnumerator class.
+        /// @param stream The stream to read lines from, which must outlive the enumerator.
+        explicit CLinqLineEnumerator(std::istream& stream) noexcept
+            : _stream(&stream)
+        {
+        }
+
+        /// Initializes a new instance of the CLinqLineEnumerator class.
+        /// @param path The path of the file to read lines from.
+        explicit CLinqLineEnumerator(std::string path) noexcept
+            : _stream(nullptr), _path(std::move(path))
+        {
+        }
+
+        /// Advances the enumerator to the next line.
+        /// @returns True if the enumerator was advanced, false if the end of the input was reached.
+        /// @throws CLinqException If the file cannot be opened or the stream cannot be read.
+        bool MoveNext()
+        {
+            if (!_state)
+            {
+                _state = Open();
+            }
+
+            auto& state = *_state;
+            auto found = false;
+            state.line.clear();
+
+            while (state.position != state.end || Fill(state))
+            {
+                auto const* const begin = state.buffer.data() + state.position;
+                auto const* const end = state.buffer.data() + state.end;
+                auto const* const newline = static_cast<char const*>(std::memchr(begin, '\n', static_cast<std::size_t>(end - begin)));
+                found = true;
+
+                if (newline != nullptr)
+                {
+                    state.line.append(begin, newline);
+                    state.position = static_cast<std::size_t>(newline - state.buffer.data()) + 1;
+                    break;
+                }
+
+                // The line continues in the next chunk.
+                state.line.append(begin, end);
+                state.position = state.end;
+            }
+
+            if (!state.line.empty() && state.line.back() == '\r')
+            {
+                state.line.pop_back();
+            }
+
+            return found;
+        }
+
+        /// Gets the line the enumerator is positioned on.
+        /// @returns The line the enumerator is positioned on, which is overwritten by the next call to MoveNext.
+        std::string const& Current() const noexcept
         {
-            return VectorContains(_elements, element);
+            return _state->line;
         }
 
-        /// Gets the number of elements in the collection.
-        /// @returns The number of elements in the collection.
-        size_type Count() const noexcept
+    private:
+        static constexpr std::size_t ChunkSize = 64 * 1024;
+
+        struct State
         {
-            return _elements.size();
+            std::unique_ptr<std::ifstream> file;
+            std::istream* stream = nullptr;
+            std::vector<char> buffer;
+            std::size_t position = 0;
+            std::size_t end = 0;
+            std::string line;
+        };
+
+        std::istream* _stream;
+        std::string _path;
+        std::shared_ptr<State> _state;
+
+        std::shared_ptr<State> Open() const
+        {
+            auto state = std::make_shared<State>();
+            state->stream = _stream;
+
+            if (state->stream == nullptr)
+            {
+                state->file = std::make_unique<std::ifstream>(_path, std::ios::binary);
+                if (!state->file->is_open())
+                {
+                    throw CLinqException("Could not open file " + _path + ".");
+                }
+
+                state->stream = state->file.get();
+            }
+
+            state->buffer.resize(ChunkSize);
+
+            return state;
         }
 
-        /// Gets the number of elements in the collection that match the given match function.
+        static bool Fill(State& state)
+        {
+            state.stream->read(state.buffer.data(), static_cast<std::streamsize>(state.buffer.size()));
+            if (state.stream->bad())
+            {
+                throw CLinqException("Could not read from stream.");
+            }
+
+            state.position = 0;
+            state.end = static_cast<std::size_t>(state.stream->gcount());
+
+            return state.end != 0;
+        }
+};
+
+/// Enumerates the elements of a source enumerator that match a match function.
+/// @tparam TEnumerator The type of the source enumerator.
+/// @tparam TMatch The type of the match function.
+export template <CLinqEnumerator TEnumerator, typename TMatch>
+class CLinqWhereEnumerator
+{
+    public:
+        using value_type = typename TEnumerator::value_type;
+
+        /// Initializes a new instance of the CLinqWhereEnumerator class.
+        /// @param source The source enumerator.
         /// @param matchFunction The match function.
-        /// @returns The number of elements that match the given match function.
-        size_type Count(MatchFunction const& matchFunction) const
+        CLinqWhereEnumerator(TEnumerator source, TMatch matchFunction)
+            : _source(std::move(source)), _matchFunction(std::move(matchFunction))
         {
-            size_type count = 0;
+        }
+
+        /// Advances the enumerator to the next matching element.
+        /// @returns True if the enumerator was advanced, false if there are no more matching elements.
+        bool MoveNext()
+        {
+            while (_source.MoveNext())
+            {
+                if (std::invoke(_matchFunction, _source.Current()))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /// Gets the element the enumerator is positioned on.
+        /// @returns The element the enumerator is positioned on.
+        decltype(auto) Current() const
+        {
+            return _source.Current();
+        }
+
+    private:
+        TEnumerator _source;
+        TMatch _matchFunction;
+};
+
+/// Enumerates the elements of a source enumerator projected by a projection function.
+/// The projection is computed once per element when the enumerator is advanced.
+/// @tparam TEnumerator The type of the source enumerator.
+/// @tparam TProjector The type of the projection function.
+export template <CLinqEnumerator TEnumerator, typename TProjector>
+class CLinqSelectEnumerator
+{
+    public:
+        using value_type = std::remove_cvref_t<
+            std::invoke_result_t<TProjector&, decltype(std::declval<TEnumerator&>().Current())>>;
+
+        /// Initializes a new instance of the CLinqSelectEnumerator class.
+        /// @param source The source enumerator.
+        /// @param projectionFunction The projection function.
+        CLinqSelectEnumerator(TEnumerator source, TProjector projectionFunction)
+            : _source(std::move(source)), _projectionFunction(std::move(projectionFunction)), _current()
+        {
+        }
+
+        /// Advances the enumerator to the next element and projects it.
+        /// @returns True if the enumerator was advanced, false if the end of the source was reached.
+        bool MoveNext()
+        {
+            if (!_source.MoveNext())
+            {
+                return false;
+            }
+
+            _current.emplace(std::invoke(_projectionFunction, _source.Current()));
+
+            return true;
+        }
+
+        /// Gets the projection of the element the enumerator is positioned on.
+        /// @returns The projection of the element the enumerator is positioned on.
+        value_type const& Current() const
+        {
+            return *_current;
+        }
+
+    private:
+        TEnumerator _source;
+        TProjector _projectionFunction;
+        std::optional<value_type> _current;
+};
+
+/// Enumerates the inner elements of the ranges a collection selector projects each element of a source
+/// enumerator to, optionally projected with their element by a result selector. Each inner range is only
+/// produced once the previous one is exhausted. If the collection selector returns a reference into an
+/// element that the source enumerator also returns by reference, the inner range is not copied.
+/// @tparam TEnumerator The type of the source enumerator.
+/// @tparam TCollectionSelector The type of the collection selector.
+/// @tparam TResultSelector The type of the result selector, or CLinqSelectInner to enumerate the inner elements.
+export template <CLinqEnumerator TEnumerator, typename TCollectionSelector, typename TResultSelector>
+class CLinqSelectManyEnumerator
+{
+    private:
+        using SourceReference = decltype(std::declval<TEnumerator&>().Current());
+        using InnerResult = std::invoke_result_t<TCollectionSelector&, SourceReference>;
+
+        static constexpr bool ReferencesInner = std::is_lvalue_reference_v<InnerResult> && std::is_lvalue_reference_v<SourceReference>;
+        static constexpr bool SelectsInner = std::is_same_v<TResultSelector, CLinqSelectInner>;
+
+        using InnerRange = std::conditional_t<ReferencesInner, std::remove_reference_t<InnerResult>, std::remove_cvref_t<InnerResult>>;
+        using InnerIterator = std::ranges::iterator_t<InnerRange>;
+        using InnerSentinel = std::ranges::sentinel_t<InnerRange>;
+
+    public:
+        using value_type = std::conditional_t<
+            SelectsInner,
+            std::ranges::range_value_t<InnerRange>,
+            std::remove_cvref_t<std::invoke_result_t<TResultSelector&, SourceReference, std::ranges::range_reference_t<InnerRange>>>>;
+
+        /// Initializes a new instance of the CLinqSelectManyEnumerator class.
+        /// @param source The source enumerator.
+        /// @param collectionSelector The collection selector.
+        /// @param resultSelector The result selector.
+        CLinqSelectManyEnumerator(TEnumerator source, TCollectionSelector collectionSelector, TResultSelector resultSelector)
+            : _source(std::move(source)),
+              _collectionSelector(std::move(collectionSelector)),
+              _resultSelector(std::move(resultSelector)),
+              _offset(0)
+        {
+        }
+
+        /// Initializes a new instance of the CLinqSelectManyEnumerator class.
+        /// The copy is positioned on the same inner element as the enumerator.
+        /// @param enumerator The enumerator to copy.
+        CLinqSelectManyEnumerator(CLinqSelectManyEnumerator const& enumerator)
+            : _source(enumerator._source),
+              _collectionSelector(enumerator._collectionSelector),
+              _resultSelector(enumerator._resultSelector),
+              _inner(enumerator._inner),
+              _offset(enumerator._offset),
+              _result(enumerator._result)
+        {
+            Reposition();
+        }
+
+        /// Initializes a new instance of the CLinqSelectManyEnumerator class.
+        /// @param enumerator The enumerator to move.
+        CLinqSelectManyEnumerator(CLinqSelectManyEnumerator&& enumerator)
+            : _source(std::move(enumerator._source)),
+              _collectionSelector(std::move(enumerator._collectionSelector)),
+              _resultSelector(std::move(enumerator._resultSelector)),
+              _inner(std::move(enumerator._inner)),
+              _offset(enumerator._offset),
+              _result(std::move(enumerator._result))
+        {
+            Reposition();
+        }
+
+        CLinqSelectManyEnumerator& operator=(CLinqSelectManyEnumerator const&) = delete;
+
+        /// Advances the enumerator to the next inner element, moving on to the next element's inner range
+        /// when the current one is exhausted.
+        /// @returns True if the enumerator was advanced, false if the end of the source was reached.
+        bool MoveNext()
+        {
+            if (_inner)
+            {
+                ++_current;
+                ++_offset;
+            }
+
+            while (!_inner || _current == _end)
+            {
+                if (!_source.MoveNext())
+                {
+                    _inner.reset();
+                    return false;
+                }
+
+                if constexpr (ReferencesInner)
+                {
+                    _inner.emplace(std::addressof(std::invoke(_collectionSelector, _source.Current())));
+                }
+                else
+                {
+                    _inner.emplace(std::invoke(_collectionSelector, _source.Current()));
+                }
+
+                _offset = 0;
+                Reposition();
+            }
+
+            if constexpr (!SelectsInner)
+            {
+                _result.emplace(std::invoke(_resultSelector, _source.Current(), *_current));
+            }
+
+            return true;
+        }
+
+        /// Gets the inner element, or its result, the enumerator is positioned on.
+        /// @returns The inner element, or its result, the enumerator is positioned on.
+        decltype(auto) Current() const
+        {
+            if constexpr (SelectsInner)
+            {
+                return *_current;
+            }
+            else
+            {
+                return static_cast<value_type const&>(*_result);
+            }
+        }
+
+    private:
+        TEnumerator _source;
+        TCollectionSelector _collectionSelector;
+        TResultSelector _resultSelector;
+        std::optional<std::conditional_t<ReferencesInner, InnerRange*, InnerRange>> _inner;
+        InnerIterator _current;
+        InnerSentinel _end;
+        std::size_t _offset;
+        std::optional<std::conditional_t<SelectsInner, char, value_type>> _result;
+
+        InnerRange& Inner() noexcept
+        {
+            if constexpr (ReferencesInner)
+            {
+                return **_inner;
+            }
+            else
+            {
+                return *_inner;
+            }
+        }
+
+        void Reposition()
+        {
+            if (_inner)
+            {
+                _current = std::ranges::next(std::ranges::begin(Inner()), static_cast<std::ranges::range_difference_t<InnerRange>>(_offset));
+                _end = std::ranges::end(Inner());
+            }
+        }
+};
+
+/// Enumerates the elements of a source enumerator after skipping a number of elements.
+/// @tparam TEnumerator The type of the source enumerator.
+export template <CLinqEnumerator TEnumerator>
+class CLinqSkipEnumerator
+{
+    public:
+        using value_type = typename TEnumerator::value_type;
+        using size_type = std::size_t;
+
+        /// Initializes a new instance of the CLinqSkipEnumerator class.
+        /// @param source The source enumerator.
+        /// @param numberOfElements The number of elements to skip.
+        CLinqSkipEnumerator(TEnumerator source, size_type const numberOfElements)
+            : _source(std::move(source)), _remaining(numberOfElements)
+        {
+        }
+
+        /// Advances the enumerator to the next element, skipping elements on the first call.
+        /// @returns True if the enumerator was advanced, false if the end of the source was reached.
+        bool MoveNext()
+        {
+            for (; _remaining > 0; --_remaining)
+            {
+                if (!_source.MoveNext())
+                {
+                    _remaining = 0;
+                    return false;
+                }
+            }
+
+            return _source.MoveNext();
+        }
+
+        /// Gets the element the enumerator is positioned on.
+        /// @returns The element the enumerator is positioned on.
+        decltype(auto) Current() const
+        {
+            return _source.Current();
+        }
+
+    private:
+        TEnumerator _source;
+        size_type _remaining;
+};
+
+/// Enumerates at most a given number of elements from a source enumerator.
+/// @tparam TEnumerator The type of the source enumerator.
+export template <CLinqEnumerator TEnumerator>
+class CLinqTakeEnumerator
+{
+    public:
+        using value_type = typename TEnumerator::value_type;
+        using size_type = std::size_t;
+
+        /// Initializes a new instance of the CLinqTakeEnumerator class.
+        /// @param source The source enumerator.
+        /// @param numberOfElements The maximum number of elements to take.
+        CLinqTakeEnumerator(TEnumerator source, size_type const numberOfElements)
+            : _source(std::move(source)), _remaining(numberOfElements)
+        {
+        }
+
+        /// Advances the enumerator to the next element. The source is not advanced once enough
+        /// elements have been taken.
+        /// @returns True if the enumerator was advanced, false otherwise.
+        bool MoveNext()
+        {
+            if (_remaining == 0)
+            {
+                return false;
+            }
+
+            --_remaining;
+
+            return _source.MoveNext();
+        }
+
+        /// Gets the element the enumerator is positioned on.
+        /// @returns The element the enumerator is positioned on.
+        decltype(auto) Current() const
+        {
+            return _source.Current();
+        }
+
+    private:
+        TEnumerator _source;
+        size_type _remaining;
+};
+
+/// Enumerates the elements of a source enumerator after skipping elements while a match function returns true.
+/// @tparam TEnumerator The type of the source enumerator.
+/// @tparam TMatch The type of the match function.
+export template <CLinqEnumerator TEnumerator, typename TMatch>
+class CLinqSkipWhileEnumerator
+{
+    public:
+        using value_type = typename TEnumerator::value_type;
+
+        /// Initializes a new instance of the CLinqSkipWhileEnumerator class.
+        /// @param source The source enumerator.
+        /// @param matchFunction The match function.
+        CLinqSkipWhileEnumerator(TEnumerator source, TMatch matchFunction)
+            : _source(std::move(source)), _matchFunction(std::move(matchFunction)), _skipping(true)
+        {
+        }
+
+        /// Advances the enumerator to the next element, skipping matching elements on the first call.
+        /// @returns True if the enumerator was advanced, false if the end of the source was reached.
+        bool MoveNext()
+        {
+            if (!_skipping)
+            {
+                return _source.MoveNext();
+            }
+
+            _skipping = false;
+            while (_source.MoveNext())
+            {
+                if (!std::invoke(_matchFunction, _source.Current()))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /// Gets the element the enumerator is positioned on.
+        /// @returns The element the enumerator is positioned on.
+        decltype(auto) Current() const
+        {
+            return _source.Current();
+        }
+
+    private:
+        TEnumerator _source;
+        TMatch _matchFunction;
+        bool _skipping;
+};
+
+/// Enumerates the elements of a source enumerator while a match function returns true.
+/// @tparam TEnumerator The type of the source enumerator.
+/// @tparam TMatch The type of the match function.
+export template <CLinqEnumerator TEnumerator, typename TMatch>
+class CLinqTakeWhileEnumerator
+{
+    public:
+        using value_type = typename TEnumerator::value_type;
+
+        /// Initializes a new instance of the CLinqTakeWhileEnumerator class.
+        /// @param source The source enumerator.
+        /// @param matchFunction The match function.
+        CLinqTakeWhileEnumerator(TEnumerator source, TMatch matchFunction)
+            : _source(std::move(source)), _matchFunction(std::move(matchFunction)), _taking(true)
+        {
+        }
+
+        /// Advances the enumerator to the next element if it matches the match function.
+        /// @returns True if the enumerator was advanced, false otherwise.
+        bool MoveNext()
+        {
+            _taking = _taking && _source.MoveNext() && std::invoke(_matchFunction, _source.Current());
+
+            return _taking;
+        }
+
+        /// Gets the element the enumerator is positioned on.
+        /// @returns The element the enumerator is positioned on.
+        decltype(auto) Current() const
+        {
+            return _source.Current();
+        }
+
+    private:
+        TEnumerator _source;
+        TMatch _matchFunction;
+        bool _taking;
+};
+
+/// Enumerates the elements of a source enumerator with the least or greatest keys, in order of key.
+/// The source is enumerated on the first call to MoveNext, keeping only the selected elements.
+/// @tparam TEnumerator The type of the source enumerator.
+/// @tparam TKeySelector The type of the key selector.
+export template <CLinqEnumerator TEnumerator, typename TKeySelector>
+class CLinqTopByEnumerator
+{
+    public:
+        using value_type = typename TEnumerator::value_type;
+        using size_type = std::size_t;
+
+        /// Initializes a new instance of the CLinqTopByEnumerator class.
+        /// @param source The source enumerator.
+        /// @param keySelector The key selector.
+        /// @param numberOfElements The maximum number of elements to take.
+        /// @param descending Whether to take the elements with the greatest rather than the least keys.
+        CLinqTopByEnumerator(
+            TEnumerator source,
+            TKeySelector keySelector,
+            size_type const numberOfElements,
+            bool const descending)
+            : _source(std::move(source)),
+              _keySelector(std::move(keySelector)),
+              _numberOfElements(numberOfElements),
+              _descending(descending),
+              _evaluated(false),
+              _position(0),
+              _elements()
+        {
+        }
+
+        /// Advances the enumerator to the next element, selecting the elements on the first call.
+        /// @returns True if the enumerator was advanced, false if every selected element was enumerated.
+        bool MoveNext()
+        {
+            if (!_evaluated)
+            {
+                Evaluate();
+                _evaluated = true;
+            }
+            else if (_position < _elements.size())
+            {
+                ++_position;
+            }
+
+            return _position < _elements.size();
+        }
+
+        /// Gets the element the enumerator is positioned on.
+        /// @returns The element the enumerator is positioned on.
+        value_type const& Current() const
+        {
+            return _elements[_position];
+        }
+
+    private:
+        using TKey = std::remove_cvref_t<
+            std::invoke_result_t<TKeySelector&, decltype(std::declval<TEnumerator&>().Current())>>;
+
+        TEnumerator _source;
+        TKeySelector _keySelector;
+        size_type _numberOfElements;
+        bool _descending;
+        bool _evaluated;
+        size_type _position;
+        std::vector<value_type> _elements;
+
+        void Evaluate()
+        {
+            if (_numberOfElements == 0)
+            {
+                return;
+            }
 
-            for (auto& element : _elements)
+            auto selection = CLinqSort::Selection<TKey, value_type>(_numberOfElements, _descending);
+            while (_source.MoveNext())
             {
-                if (matchFunction(element))
-                {
-                    ++count;
-                }
+                decltype(auto) element = _source.Current();
+                selection.Offer(std::invoke(_keySelector, element), [&element]() { return value_type(element); });
             }
 
-            return count;
+            _elements = std::move(selection).Values();
         }
+};
 
-        /// Gets the distinct elements of the collection.
-        /// @returns Gets the distinct elements of the collection.
-        CLinqCollection<TElement> Distinct() const
+/// A lazily evaluated query supporting CLinq methods.
+/// Operators compose into a single fused enumerator and elements are only visited when the
+/// query is materialised, e.g. by ToVector, First or Count. Materialising a query enumerates
+/// a copy of its enumerator, so a query may be materialised more than once if its source allows it.
+/// @tparam TEnumerator The type of the enumerator producing the elements of the query.
+export template <CLinqEnumerator TEnumerator>
+class CLinqQuery
+{
+    public:
+        using value_type = typename TEnumerator::value_type;
+        using reference = decltype(std::declval<TEnumerator&>().Current());
+        using size_type = std::size_t;
+
+        /// Initializes a new instance of the CLinqQuery class.
+        /// @param enumerator The enumerator producing the elements of the query.
+        explicit CLinqQuery(TEnumerator enumerator)
+            : _enumerator(std::move(enumerator))
         {
-            auto newElements = std::vector<TElement>();
+        }
 
-            for (auto& element : _elements)
+        /// Applies an accumulator function over the elements of the query, in order, starting from a seed.
+        /// @tparam TAccumulate The type of the accumulated value.
+        /// @tparam TAccumulator The type of the accumulator function.
+        /// @param seed The initial accumulated value.
+        /// @param accumulator Combines the accumulated value with the next element.
+        /// @returns The final accumulated value.
+        template <typename TAccumulate, typename TAccumulator>
+            requires std::invocable<TAccumulator&, TAccumulate, reference>
+        TAccumulate Aggregate(TAccumulate seed, TAccumulator&& accumulator) const
+        {
+            auto enumerator = _enumerator;
+            while (enumerator.MoveNext())
             {
-                if (!VectorContains(newElements, element))
-                {
-                    newElements.emplace_back(element);
-                }
+                seed = std::invoke(accumulator, std::move(seed), enumerator.Current());
             }
 
-            return CLinqCollection<TElement>(newElements);
+            return seed;
         }
 
-        /// Gets the elements in this collection with elements in the given collection omitted.
-        /// @param collection The collection.
-        /// @returns The elements in this collection with elements in the given collection omitted.
-        CLinqCollection<TElement> Except(CLinqCollection<TElement> const& collection) const
+        /// Applies an accumulator function over the elements of the query, in order, starting from a seed,
+        /// and projects the final accumulated value.
+        /// @tparam TAccumulate The type of the accumulated value.
+        /// @tparam TAccumulator The type of the accumulator function.
+        /// @tparam TResultSelector The type of the result selector.
+        /// @param seed The initial accumulated value.
+        /// @param accumulator Combines the accumulated value with the next element.
+        /// @param resultSelector Projects the final accumulated value.
+        /// @returns The projection of the final accumulated value.
+        template <typename TAccumulate, typename TAccumulator, typename TResultSelector>
+            requires std::invocable<TAccumulator&, TAccumulate, reference> &&
+                std::invocable<TResultSelector&, TAccumulate>
+        auto Aggregate(TAccumulate seed, TAccumulator&& accumulator, TResultSelector&& resultSelector) const
         {
-            auto newElements = std::vector<TElement>();
+            return std::invoke(resultSelector, Aggregate(std::move(seed), accumulator));
+        }
 
-            for (auto& element : _elements)
+        /// Checks that every element in the query matches the given match function.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns True if every element in the query matches the given match function, false otherwise.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, reference>
+        bool All(TMatch&& matchFunction) const
+        {
+            auto enumerator = _enumerator;
+            while (enumerator.MoveNext())
             {
-                if (!VectorContains(collection._elements, element))
+                if (!std::invoke(matchFunction, enumerator.Current()))
                 {
-                    newElements.emplace_back(element);
+                    return false;
                 }
             }
 
-            return CLinqCollection<TElement>(newElements);
+            return true;
         }
 
-        /// Gets a const reference to the first element in the collection.
-        /// @returns A const reference to the first element in the collection.
-        TElement const& First() const
+        /// Checks if the query contains any element.
+        /// @returns True if the query contains any element, false otherwise.
+        bool Any() const
         {
-            ThrowIfEmpty();
+            auto enumerator = _enumerator;
 
-            return _elements.front();
+            return enumerator.MoveNext();
         }
 
-        /// Computes the set intersection of this collection and the given collection.
-        /// @param collection The collection.
-        /// @returns The set intersection of this collection and the given collection.
-        CLinqCollection<TElement> Intersection(CLinqCollection<TElement> const& collection) const
+        /// Checks if the query contains any element that matches the given function.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns True if the query contains any element that matches the given function, false otherwise.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, reference>
+        bool Any(TMatch&& matchFunction) const
         {
-            auto newElements = std::vector<TElement>();
-
-            for (auto& element : _elements)
+            auto enumerator = _enumerator;
+            while (enumerator.MoveNext())
             {
-                if (VectorContains(_elements, element) && VectorContains(collection._elements, element))
+                if (std::invoke(matchFunction, enumerator.Current()))
                 {
-                    newElements.emplace_back(element);
+                    return true;
                 }
             }
 
-            return CLinqCollection<TElement>(newElements);
+            return false;
         }
 
-        /// Gets a const reference to the last element in the collection.
-        /// @returns A const reference to the last element in the collection.
-        TElement const& Last() const
+        /// Checks whether or not the query contains the given element.
+        /// @param element The element to find.
+        /// @returns True if the query contains the given element, false otherwise.
+        bool Contains(value_type const& element) const
         {
-            ThrowIfEmpty();
-
-            return _elements.back();
+            return Any([&element](auto const& current) { return current == element; });
         }
 
-        /// Prepends the element to the collection.
-        /// @param element The element.
-        /// @returns A new collection with the element prepended.
-        CLinqCollection<TElement> Prepend(TElement const& element) const
+        /// Gets the number of elements in the query.
+        /// @returns The number of elements in the query.
+        size_type Count() const
         {
-            auto newElements = _elements;
-            newElements.emplace(newElements.begin(), element);
-
-            return CLinqCollection<TElement>(newElements);
-        }
+            size_type count = 0;
+            auto enumerator = _enumerator;
+            while (enumerator.MoveNext())
+            {
+                ++count;
+            }
 
-        /// Gets the collection in reverse order.
-        /// @returns The collection in reverse order.
-        CLinqCollection<TElement> Reverse() const
-        {
-            auto newElements = _elements;
-            std::reverse(newElements.begin(), newElements.end());
-            return CLinqCollection<TElement>(newElements);
+            return count;
         }
 
-        /// Projects each element to a new sequence using the projection function.
-        /// @tparam TProjection The type to project the elements to.
-        /// @param projectionFunction The projection function/
-        /// @returns Each element projected into a new sequence.
-        template <typename TProjection>
-        CLinqCollection<TProjection> Select(ProjectionFunction<TProjection> const& projectionFunction) const
+        /// Gets the number of elements in the query that match the given match function.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns The number of elements that match the given match function.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, reference>
+        size_type Count(TMatch&& matchFunction) const
         {
-            auto newElements = std::vector<TProjection>(_elements.size());
-
-            for (size_type i = 0; i < _elements.size(); ++i)
+            size_type count = 0;
+            auto enumerator = _enumerator;
+            while (enumerator.MoveNext())
             {
-                newElements[i] = projectionFunction(_elements[i]);
+                if (std::invoke(matchFunction, enumerator.Current()))
+                {
+                    ++count;
+                }
             }
 
-            return CLinqCollection<TProjection>(newElements);
+            return count;
         }
 
-        /// Returns the only element of the sequence.
-        /// @returns A reference to the single element of the sequence.
-        /// @throws CLinqException If 0 or many elements are contained within the collection.
-        TElement const& Single() const
+        /// Gets the first element in the query. Only the first element is evaluated.
+        /// @returns The first element in the query.
+        /// @throws CLinqException When the query is empty.
+        value_type First() const
         {
-            ThrowIfEmpty();
-            if (_elements.size() > 1)
+            auto enumerator = _enumerator;
+            if (!enumerator.MoveNext())
             {
-                throw CLinqException("Collection contains more than 1 element.");
+                throw CLinqException("Collection is empty.");
             }
 
-            return _elements[0];
+            return enumerator.Current();
         }
 
-        /// Skips a given number of elements and returns the rest.
-        /// @param numberOfElements The number of elements to skip.
-        /// @returns The remainder of the elements after skipping n.
-        CLinqCollection<TElement> Skip(size_type const numberOfElements) const
+        /// Projects each element of the query using the projection function.
+        /// @tparam TProjector The type of the projection function.
+        /// @param projectionFunction The projection function.
+        /// @returns A query over the projected elements.
+        template <typename TProjector>
+            requires std::invocable<TProjector&, reference>
+        CLinqQuery<CLinqSelectEnumerator<TEnumerator, std::decay_t<TProjector>>> Select(TProjector&& projectionFunction) const
         {
-            if (numberOfElements > _elements.size())
-            {
-                throw CLinqException("Cannot skip more elements than exist in collection.");
-            }
+            return CLinqQuery<CLinqSelectEnumerator<TEnumerator, std::decay_t<TProjector>>>(
+                CLinqSelectEnumerator<TEnumerator, std::decay_t<TProjector>>(_enumerator, std::forward<TProjector>(projectionFunction)));
+        }
 
-            return CLinqCollection<TElement>(std::vector<TElement>(_elements.begin() + numberOfElements, _elements.end()));
+        /// Projects each element of the query to a range and flattens the ranges into one query.
+        /// @tparam TCollectionSelector The type of the collection selector.
+        /// @param collectionSelector Projects each element to a range of inner elements.
+        /// @returns A query over the inner elements of every element, in order.
+        template <typename TCollectionSelector>
+            requires CLinqCollectionSelector<TCollectionSelector, reference> &&
+                std::ranges::forward_range<std::invoke_result_t<TCollectionSelector&, reference>>
+        CLinqQuery<CLinqSelectManyEnumerator<TEnumerator, std::decay_t<TCollectionSelector>, CLinqSelectInner>> SelectMany(
+            TCollectionSelector&& collectionSelector) const
+        {
+            return CLinqQuery<CLinqSelectManyEnumerator<TEnumerator, std::decay_t<TCollectionSelector>, CLinqSelectInner>>(
+                CLinqSelectManyEnumerator<TEnumerator, std::decay_t<TCollectionSelector>, CLinqSelectInner>(
+                    _enumerator, std::forward<TCollectionSelector>(collectionSelector), CLinqSelectInner()));
         }
 
-        /// Skips a given number of elements from the back of the collection and returns the rest.
-        /// @param numberOfElements The number of elements to skip from the back.
-        /// @returns The remainder of the elements after skipping n from the back of the collection.
-        CLinqCollection<TElement> SkipLast(size_type const numberOfElements) const
+        /// Projects each element of the query to a range and projects each pair of element and inner
+        /// element to a result.
+        /// @tparam TCollectionSelector The type of the collection selector.
+        /// @tparam TResultSelector The type of the result selector.
+        /// @param collectionSelector Projects each element to a range of inner elements.
+        /// @param resultSelector Projects an element and one of its inner elements to a result.
+        /// @returns A query over the results for every inner element of every element, in order.
+        template <typename TCollectionSelector, typename TResultSelector>
+            requires CLinqCollectionSelector<TCollectionSelector, reference> &&
+                std::ranges::forward_range<std::invoke_result_t<TCollectionSelector&, reference>> &&
+                std::invocable<
+                    TResultSelector&,
+                    reference,
+                    std::ranges::range_reference_t<std::invoke_result_t<TCollectionSelector&, reference>>>
+        CLinqQuery<CLinqSelectManyEnumerator<TEnumerator, std::decay_t<TCollectionSelector>, std::decay_t<TResultSelector>>> SelectMany(
+            TCollectionSelector&& collectionSelector,
+            TResultSelector&& resultSelector) const
         {
-            if (numberOfElements > _elements.size())
-            {
-                throw CLinqException("Cannot skip more elements than exist in collection.");
-            }
+            return CLinqQuery<CLinqSelectManyEnumerator<TEnumerator, std::decay_t<TCollectionSelector>, std::decay_t<TResultSelector>>>(
+                CLinqSelectManyEnumerator<TEnumerator, std::decay_t<TCollectionSelector>, std::decay_t<TResultSelector>>(
+                    _enumerator,
+                    std::forward<TCollectionSelector>(collectionSelector),
+                    std::forward<TResultSelector>(resultSelector)));
+        }
 
-            return CLinqCollection<TElement>(std::vector<TElement>(_elements.begin(), _elements.end() - numberOfElements));
+        /// Skips a given number of elements. Unlike CLinqCollection::Skip, skipping more elements
+        /// than the query produces gives an empty query, as the number of elements is not known up front.
+        /// @param numberOfElements The number of elements to skip.
+        /// @returns A query over the remainder of the elements after skipping n.
+        CLinqQuery<CLinqSkipEnumerator<TEnumerator>> Skip(size_type const numberOfElements) const
+        {
+            return CLinqQuery<CLinqSkipEnumerator<TEnumerator>>(CLinqSkipEnumerator<TEnumerator>(_enumerator, numberOfElements));
         }
 
-        /// Skips elements while the match function returns true and returns the remainder of the collection.
+        /// Skips elements while the match function returns true.
+        /// @tparam TMatch The type of the match function.
         /// @param matchFunction The match function.
-        /// @returns A new collection with the elements skipped until the match function returns false.
-        CLinqCollection<TElement> SkipWhile(MatchFunction const& matchFunction) const
+        /// @returns A query over the elements after the match function first returns false.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, reference>
+        CLinqQuery<CLinqSkipWhileEnumerator<TEnumerator, std::decay_t<TMatch>>> SkipWhile(TMatch&& matchFunction) const
         {
-            size_type skipNumber = 0;
-            for (auto& element : _elements)
-            {
-                if (matchFunction(element))
-                {
-                    ++skipNumber;
-                }
-                else
-                {
-                    break;
-                }
-            }
-
-            return Skip(skipNumber);
+            return CLinqQuery<CLinqSkipWhileEnumerator<TEnumerator, std::decay_t<TMatch>>>(
+                CLinqSkipWhileEnumerator<TEnumerator, std::decay_t<TMatch>>(_enumerator, std::forward<TMatch>(matchFunction)));
         }
 
-        /// Static casts each element of the collection to a new collection.
+        /// Static casts each element of the query.
         /// @tparam TCast The type to cast to.
-        /// @param collection The collection to cast.
-        /// @returns The casted collection.
+        /// @returns A query over the cast elements.
         template <typename TCast>
-        CLinqCollection<TCast> StaticCast() const
+        auto StaticCast() const
         {
             static_assert(
-                std::is_convertible<TElement, TCast>::value,
-                "Cannot cast StaticCast CLinqCollection.");
-
-            auto newElements = std::vector<TCast>(_elements.size());
-
-            for (size_type i = 0; i < _elements.size(); ++i)
-            {
-                newElements[i] = static_cast<TCast>(_elements[i]);
-            }
+                std::is_convertible<value_type, TCast>::value,
+                "Cannot cast StaticCast CLinqQuery.");
 
-            return CLinqCollection<TCast>(newElements);
+            return Select([](auto const& element) { return static_cast<TCast>(element); });
         }
 
-        /// Takes a specific number of elements from the start of the collection.
+        /// Takes at most a given number of elements. Unlike CLinqCollection::Take, taking more elements
+        /// than the query produces is not an error, as the number of elements is not known up front.
         /// @param numberOfElements The number of elements to take.
-        /// @returns A new collection with the first n elements from the collection.
-        CLinqCollection<TElement> Take(size_type const numberOfElements) const
+        /// @returns A query over the first n elements.
+        CLinqQuery<CLinqTakeEnumerator<TEnumerator>> Take(size_type const numberOfElements) const
         {
-            if (numberOfElements > _elements.size())
-            {
-                throw CLinqException("Cannot take more elements than exist in collection.");
-            }
-
-            auto newElements = _elements;
-            newElements.resize(numberOfElements);
+            return CLinqQuery<CLinqTakeEnumerator<TEnumerator>>(CLinqTakeEnumerator<TEnumerator>(_enumerator, numberOfElements));
+        }
 
-            return CLinqCollection<TElement>(newElements);
+        /// Takes elements while the match function returns true.
+        /// @tparam TMatch The type of the match function.
+        /// @param matchFunction The match function.
+        /// @returns A query over the elements until the match function first returns false.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, reference>
+        CLinqQuery<CLinqTakeWhileEnumerator<TEnumerator, std::decay_t<TMatch>>> TakeWhile(TMatch&& matchFunction) const
+        {
+            return CLinqQuery<CLinqTakeWhileEnumerator<TEnumerator, std::decay_t<TMatch>>>(
+                CLinqTakeWhileEnumerator<TEnumerator, std::decay_t<TMatch>>(_enumerator, std::forward<TMatch>(matchFunction)));
         }
 
-        /// Takes a specific number of elements from the end of the collection.
+        /// Takes at most a given number of elements with the least keys, in ascending order of key.
+        /// Only the taken elements are kept, so taking k of n elements takes O(n log k) time and O(k) memory.
+        /// Unlike CLinqCollection::TopBy, taking more elements than the query produces is not an error.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
         /// @param numberOfElements The number of elements to take.
-        /// @returns A new collection with the last n elements from the collection.
-        CLinqCollection<TElement> TakeLast(size_type const numberOfElements) const
+        /// @returns A query over the n elements with the least keys.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, reference>
+        CLinqQuery<CLinqTopByEnumerator<TEnumerator, std::decay_t<TKeySelector>>> TopBy(
+            TKeySelector&& keySelector,
+            size_type const numberOfElements) const
         {
-            if (numberOfElements > _elements.size())
-            {
-                throw CLinqException("Cannot take more elements than exist in collection.");
-            }
+            return CLinqQuery<CLinqTopByEnumerator<TEnumerator, std::decay_t<TKeySelector>>>(
+                CLinqTopByEnumerator<TEnumerator, std::decay_t<TKeySelector>>(
+                    _enumerator, std::forward<TKeySelector>(keySelector), numberOfElements, false));
+        }
 
-            return CLinqCollection<TElement>(std::vector<TElement>(_elements.end() - numberOfElements, _elements.end()));
+        /// Takes at most a given number of elements with the greatest keys, in descending order of key.
+        /// Only the taken elements are kept, so taking k of n elements takes O(n log k) time and O(k) memory.
+        /// Unlike CLinqCollection::TopByDescending, taking more elements than the query produces is not an error.
+        /// @tparam TKeySelector The type of the key selector.
+        /// @param keySelector The key selector.
+        /// @param numberOfElements The number of elements to take.
+        /// @returns A query over the n elements with the greatest keys.
+        template <typename TKeySelector>
+            requires std::invocable<TKeySelector&, reference>
+        CLinqQuery<CLinqTopByEnumerator<TEnumerator, std::decay_t<TKeySelector>>> TopByDescending(
+            TKeySelector&& keySelector,
+            size_type const numberOfElements) const
+        {
+            return CLinqQuery<CLinqTopByEnumerator<TEnumerator, std::decay_t<TKeySelector>>>(
+                CLinqTopByEnumerator<TEnumerator, std::decay_t<TKeySelector>>(
+                    _enumerator, std::forward<TKeySelector>(keySelector), numberOfElements, true));
         }
 
-        /// Takes elements while the match function returns true.
+        /// Filters the query to the elements that match the match function.
+        /// @tparam TMatch The type of the match function.
         /// @param matchFunction The match function.
-        /// @returns A new collection with the elements taken until the match function returns false.
-        CLinqCollection<TElement> TakeWhile(MatchFunction const& matchFunction) const
+        /// @returns A query over the elements that match the match function.
+        template <typename TMatch>
+            requires std::predicate<TMatch&, reference>
+        CLinqQuery<CLinqWhereEnumerator<TEnumerator, std::decay_t<TMatch>>> Where(TMatch&& matchFunction) const
         {
-            auto newElements = std::vector<TElement>();
-
-            for (auto& element : _elements)
-            {
-                if (matchFunction(element))
-                {
-                    newElements.emplace_back(element);
-                }
-                else
-                {
-                    break;
-                }
-            }
-
-            return CLinqCollection<TElement>(newElements);
+            return CLinqQuery<CLinqWhereEnumerator<TEnumerator, std::decay_t<TMatch>>>(
+                CLinqWhereEnumerator<TEnumerator, std::decay_t<TMatch>>(_enumerator, std::forward<TMatch>(matchFunction)));
         }
 
-        /// Gets a collection of elements from the collection that match the match function.
-        /// @param matchFunction The match function/
-        /// @returns A collection of elements from the collection that match the match function.
-        CLinqCollection<TElement> Where(MatchFunction const& matchFunction) const
+        /// Evaluates the query into a generator, which evaluates one element each time it is advanced.
+        /// The generator can be iterated with a range based for loop.
+        /// @returns A generator over the elements of the query.
+        CLinqGenerator<value_type> ToGenerator() const
         {
-            auto newElements = std::vector<TElement>();
-
-            for (auto& element : _elements)
-            {
-                if (matchFunction(element))
-                {
-                    newElements.emplace_back(element);
-                }
-            }
-
-            return CLinqCollection<TElement>(newElements);
+            return Generate(_enumerator);
         }
 
-        /// Computes the set union of this collection and the given collection.
-        /// @param collection The collection.
-        /// @returns The set union of this collection and the given collection.
-        CLinqCollection<TElement> Union(CLinqCollection<TElement> const& collection) const
+        /// Evaluates the query into a collection.
+        /// @tparam TAllocator The allocator of the collection.
+        /// @param allocator The allocator.
+        /// @returns A collection containing the elements of the query.
+        template <typename TAllocator = std::allocator<value_type>>
+        CLinqCollection<value_type, TAllocator> ToCollection(TAllocator const& allocator = TAllocator()) const
         {
-            auto newElements = Distinct()._elements;
-            auto distinctCollection = collection.Distinct()._elements;
+            return CLinqCollection<value_type, TAllocator>(ToVector(allocator));
+        }
 
-            for (auto& element : distinctCollection)
+        /// Evaluates the query into a vector.
+        /// @tparam TAllocator The allocator of the vector.
+        /// @param allocator The allocator.
+        /// @returns A vector containing the elements of the query.
+        template <typename TAllocator = std::allocator<value_type>>
+        std::vector<value_type, TAllocator> ToVector(TAllocator const& allocator = TAllocator()) const
+        {
+            auto elements = std::vector<value_type, TAllocator>(allocator);
+            auto enumerator = _enumerator;
+            while (enumerator.MoveNext())
             {
-                if (!VectorContains(newElements, element))
-                {
-                    newElements.emplace_back(element);
-                }
+                elements.emplace_back(enumerator.Current());
             }
 
-            return CLinqCollection<TElement>(newElements);
+            return elements;
         }
 
-        /// Gets the elements in the collection as a vector.
-        /// @returns The elements in the collection as a vector.
-        std::vector<TElement> ToVector() const noexcept
-        {
-            return _elements;
-        }
+    private:
+        TEnumerator _enumerator;
 
-        /// Gets the elements in the collection as a list.
-        /// @returns The elements in the collection as a list.
-        std::list<TElement> ToList() const
+        static CLinqGenerator<value_type> Generate(TEnumerator enumerator)
         {
-            return std::list(_elements.begin(), _elements.end());
+            while (enumerator.MoveNext())
+            {
+                co_yield enumerator.Current();
+            }
         }
+};
 
-        /// Gets the elements in the collection as a set.
-        /// @returns The elements in the collection as a set.
-        std::list<TElement> ToSet() const
-        {
-            return std::set(_elements.begin(), _elements.end());
-        }
+/// Creates queries over sources which are not held in memory.
+export class CLinq final
+{
+    public:
+        CLinq() = delete;
 
-        /// Projects the collection to a map.
-        /// @tparam TKey The type of the map's keys.
-        /// @tparam TValue The type of the map's values.
-        /// @param keySelector A projection function for the keys.
-        /// @param valueSelector A projection function for the values.
-        /// @returns A map from the elements in the collection.
-        template <typename TKey, typename TValue>
-        std::map<TKey, TValue> ToMap(
-            ProjectionFunction<TKey> const& keySelector,
-            ProjectionFunction<TValue> const& valueSelector) const
+        /// Creates a query over the lines of a file. The file is streamed in fixed size chunks
+        /// whenever the query is evaluated, so files larger than memory can be queried.
+        /// @param path The path of the file.
+        /// @returns A query over the lines of the file.
+        static CLinqQuery<CLinqLineEnumerator> FromFile(std::string path)
         {
-            return ToMapCore<std::map<TKey, TValue>>(keySelector, valueSelector);
+            return CLinqQuery<CLinqLineEnumerator>(CLinqLineEnumerator(std::move(path)));
         }
 
-        /// Projects the collection to an unordered map.
-        /// @tparam TKey The type of the map's keys.
-        /// @tparam TValue The type of the map's values.
-        /// @param keySelector A projection function for the keys.
-        /// @param valueSelector A projection function for the values.
-        /// @returns An unordered map from the elements in the collection.
-        template <typename TKey, typename TValue>
-        std::unordered_map<TKey, TValue> ToUnorderedMap(
-            ProjectionFunction<TKey> const& keySelector,
-            ProjectionFunction<TValue> const& valueSelector) const
+        /// Creates a query over records parsed from the lines of a file. The file is streamed in fixed
+        /// size chunks whenever the query is evaluated, so files larger than memory can be queried.
+        /// @tparam TParser The type of the parser.
+        /// @param path The path of the file.
+        /// @param parser Parses a record from a line of the file.
+        /// @returns A query over the parsed records.
+        template <typename TParser>
+            requires std::invocable<TParser&, std::string const&>
+        static auto FromFile(std::string path, TParser&& parser)
         {
-            return ToMapCore<std::unordered_map<TKey, TValue>>(keySelector, valueSelector);
+            return FromFile(std::move(path)).Select(std::forward<TParser>(parser));
         }
 
-    private:
-        std::vector<TElement> _elements;
-
+        /// Creates a query over the values produced by a generator, which are produced as the query is
+        /// evaluated, so the generator may be unbounded as long as the query stops early, e.g. with First or Take.
+        /// The query consumes the generator, so it can only be evaluated once.
+        /// @tparam T The type of values produced by the generator.
+        /// @param generator The generator.
+        /// @returns A query over the values produced by the generator.
         template <typename T>
-        static bool VectorContains(std::vector<T> const& vector, T const& value)
+        static CLinqQuery<CLinqGeneratorEnumerator<T>> FromGenerator(CLinqGenerator<T>&& generator)
         {
-            return std::find(vector.begin(), vector.end(), value) != vector.end();
+            return CLinqQuery<CLinqGeneratorEnumerator<T>>(CLinqGeneratorEnumerator<T>(std::move(generator)));
         }
 
-        void ThrowIfOutOfRange(size_type const index) const
+        /// Creates a query over the lines of a stream. The stream is read in fixed size chunks when
+        /// the query is evaluated, which consumes it, so the query can only be evaluated once.
+        /// @param stream The stream, which must outlive the query.
+        /// @returns A query over the lines of the stream.
+        static CLinqQuery<CLinqLineEnumerator> FromLines(std::istream& stream)
         {
-            if (index >= _elements.size())
-            {
-                throw CLinqException("Index was out of range."
-                    "Attemped to access index " + std::to_string(index) +
-                    "but collection contains " + std::to_string(_elements.size()) + " elements.");
-            }
+            return CLinqQuery<CLinqLineEnumerator>(CLinqLineEnumerator(stream));
         }
 
-        void ThrowIfEmpty() const
+        /// Creates a query starting from the initial value and prefix incrementing it n times.
+        /// Unlike CLinqCollection::Range, the values are produced as the query is evaluated rather than stored.
+        /// @tparam T The type of values.
+        /// @param initial The initial value.
+        /// @param count The number of values.
+        /// @returns A query starting from the initial value and prefix incrementing it n times.
+        template <typename T>
+        static CLinqQuery<CLinqRangeEnumerator<T>> Range(T initial, std::size_t const count)
         {
-            if (_elements.empty())
-            {
-                throw CLinqException("Collection is empty.");
-            }
+            return CLinqQuery<CLinqRangeEnumerator<T>>(CLinqRangeEnumerator<T>(std::move(initial), count));
         }
 
-        template <typename TMap, typename TKey, typename TValue>
-        TMap ToMapCore(
-            ProjectionFunction<TKey> const& keySelector,
-            ProjectionFunction<TValue> const& valueSelector) const
+        /// Creates a query containing the same value n times.
+        /// Unlike CLinqCollection::Repeat, the value is stored once rather than copied n times.
+        /// @tparam T The type of the value.
+        /// @param element The value.
+        /// @param count The number of times to repeat the value.
+        /// @returns A query containing the same value n times.
+        template <typename T>
+        static CLinqQuery<CLinqRepeatEnumerator<T>> Repeat(T element, std::size_t const count)
         {
-            TMap map{};
-
-            for (auto& element : _elements)
-            {
-                map[keySelector(element)] = valueSelector(element);
-            }
-
-            return map;
+            return CLinqQuery<CLinqRepeatEnumerator<T>>(CLinqRepeatEnumerator<T>(std::move(element), count));
         }
-};
\ No newline at end of file
+};
+
+#pragma pop_macro("max")
+#pragma pop_macro("min")
\ No newline at end of file
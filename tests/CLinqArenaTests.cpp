@@ -0,0 +1,185 @@
+/// @file CLinqArenaTests.cpp
+/// Unit tests for the CLinqArena and CLinqArenaAllocator types.
+
+import CLinq;
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "catch.hpp"
+
+SCENARIO("CLinqArenas allocate by bumping a pointer")
+{
+    GIVEN("An arena")
+    {
+        auto arena = CLinqArena(1024);
+
+        THEN("Nothing has been allocated")
+        {
+            REQUIRE(0 == arena.BytesAllocated());
+        }
+
+        WHEN("Memory of different alignments is allocated")
+        {
+            auto* const first = arena.Allocate(3, 1);
+            auto* const second = arena.Allocate(8, 8);
+            auto* const third = arena.Allocate(64, 64);
+
+            THEN("The memory is aligned and does not overlap")
+            {
+                REQUIRE(0 == reinterpret_cast<std::uintptr_t>(second) % 8);
+                REQUIRE(0 == reinterpret_cast<std::uintptr_t>(third) % 64);
+                REQUIRE(static_cast<std::byte*>(first) + 3 <= static_cast<std::byte*>(second));
+                REQUIRE(static_cast<std::byte*>(second) + 8 <= static_cast<std::byte*>(third));
+                REQUIRE(75 == arena.BytesAllocated());
+            }
+        }
+
+        WHEN("More memory than a block is allocated")
+        {
+            auto* const small = static_cast<std::byte*>(arena.Allocate(16, 16));
+            auto* const large = static_cast<std::byte*>(arena.Allocate(100000, 16));
+            large[0] = std::byte{ 1 };
+            large[99999] = std::byte{ 2 };
+
+            THEN("A new block is allocated")
+            {
+                REQUIRE(small != large);
+                REQUIRE(100016 == arena.BytesAllocated());
+            }
+
+            AND_WHEN("The arena is released")
+            {
+                arena.Release();
+
+                THEN("Its memory can be reused")
+                {
+                    REQUIRE(0 == arena.BytesAllocated());
+                    REQUIRE(large == arena.Allocate(16, 16));
+                }
+            }
+        }
+    }
+
+    GIVEN("An arena over a buffer")
+    {
+        alignas(16) std::byte buffer[256];
+        auto arena = CLinqArena(buffer, sizeof(buffer));
+
+        WHEN("Memory which fits in the buffer is allocated")
+        {
+            auto* const memory = static_cast<std::byte*>(arena.Allocate(128, 16));
+
+            THEN("The memory comes from the buffer")
+            {
+                REQUIRE(buffer == memory);
+            }
+        }
+
+        WHEN("Memory which does not fit in the buffer is allocated")
+        {
+            auto* const memory = static_cast<std::byte*>(arena.Allocate(512, 16));
+
+            THEN("The memory comes from the heap")
+            {
+                REQUIRE((memory < buffer || memory >= buffer + sizeof(buffer)));
+            }
+        }
+    }
+}
+
+SCENARIO("CLinqArenaCollections allocate every result from their arena")
+{
+    GIVEN("A collection allocated from an arena")
+    {
+        auto arena = CLinqArena();
+        auto const collection = CLinqArenaCollection<int>({ 1, 2, 3, 4, 5, 6, 3, 2 }, arena);
+
+        THEN("The collection allocates from the arena")
+        {
+            REQUIRE(&arena == &collection.get_allocator().Arena());
+            REQUIRE(8 * sizeof(int) == arena.BytesAllocated());
+        }
+
+        WHEN("Operators are chained")
+        {
+            auto const before = arena.BytesAllocated();
+            auto const result = collection
+                .Where([](int const x) { return x % 2 == 0; })
+                .Select([](int const x) { return x * 0.5; })
+                .Reverse();
+
+            THEN("Every result is allocated from the arena")
+            {
+                REQUIRE(std::vector<double>{ 1, 3, 2, 1 } == std::vector<double>(result.cbegin(), result.cend()));
+                REQUIRE(&arena == &result.get_allocator().Arena());
+                REQUIRE(arena.BytesAllocated() > before);
+            }
+        }
+
+        WHEN("Set operators are used")
+        {
+            auto const other = CLinqArenaCollection<int>({ 5, 6, 7 }, arena);
+            auto const distinct = collection.Distinct();
+            auto const unioned = collection.Union(other);
+            auto const except = collection.Except(other);
+
+            THEN("The results are allocated from the arena")
+            {
+                REQUIRE(std::vector<int>{ 1, 2, 3, 4, 5, 6 } == std::vector<int>(distinct.cbegin(), distinct.cend()));
+                REQUIRE(std::vector<int>{ 1, 2, 3, 4, 5, 6, 7 } == std::vector<int>(unioned.cbegin(), unioned.cend()));
+                REQUIRE(std::vector<int>{ 1, 2, 3, 4, 3, 2 } == std::vector<int>(except.cbegin(), except.cend()));
+                REQUIRE(&arena == &distinct.get_allocator().Arena());
+                REQUIRE(&arena == &collection.ToHashSet().Keys().get_allocator().Arena());
+            }
+        }
+
+        WHEN("Elements are cast, sliced and copied")
+        {
+            auto const cast = collection.StaticCast<long long>();
+            auto const skipped = collection.Skip(2).Take(3);
+            auto const copy = collection;
+
+            THEN("The results are allocated from the arena")
+            {
+                REQUIRE(&arena == &cast.get_allocator().Arena());
+                REQUIRE(&arena == &skipped.get_allocator().Arena());
+                REQUIRE(&arena == &copy.get_allocator().Arena());
+                REQUIRE(std::vector<int>{ 3, 4, 5 } == std::vector<int>(skipped.cbegin(), skipped.cend()));
+            }
+        }
+
+        WHEN("A query or view is materialised into the arena")
+        {
+            auto const allocator = CLinqArenaAllocator<int>(arena);
+            auto const queried = collection.AsQuery().Where([](int const x) { return x > 4; }).ToCollection(allocator);
+            auto const viewed = collection.AsView().TakeLast(2).ToCollection(allocator);
+
+            THEN("The results are allocated from the arena")
+            {
+                REQUIRE(std::vector<int>{ 5, 6 } == std::vector<int>(queried.cbegin(), queried.cend()));
+                REQUIRE(std::vector<int>{ 3, 2 } == std::vector<int>(viewed.cbegin(), viewed.cend()));
+                REQUIRE(&arena == &queried.get_allocator().Arena());
+                REQUIRE(&arena == &viewed.get_allocator().Arena());
+            }
+        }
+    }
+
+    GIVEN("A collection of strings allocated from an arena")
+    {
+        auto arena = CLinqArena();
+        auto const collection = CLinqArenaCollection<std::string>::Repeat("hello", 3, arena);
+
+        WHEN("The collection is moved into a parallel collection")
+        {
+            auto const parallel = CLinqArenaCollection<std::string>(collection).AsParallel(2);
+
+            THEN("The parallel collection owns the elements")
+            {
+                REQUIRE(3 == parallel.Count());
+                REQUIRE(parallel.All([](std::string const& x) { return x == "hello"; }));
+            }
+        }
+    }
+}
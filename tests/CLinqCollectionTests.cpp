@@ -3,8 +3,19 @@
 
 import CLinq;
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <map>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include "catch.hpp"
 
 TEST_CASE("CLinqCollection iterators")
@@ -402,6 +413,52 @@ SCENARIO("CLinqCollections can check if all values match a function")
     }
 }
 
+SCENARIO("CLinqCollections can be aggregated from a seed")
+{
+    GIVEN("A nonempty collection")
+    {
+        auto collection = CLinqCollection<int>({ 1, 2, 3, 4 });
+
+        WHEN("The elements are aggregated")
+        {
+            auto sum = collection.Aggregate(10, [](int const accumulated, int const i) { return accumulated + i; });
+            auto joined = collection.Aggregate(std::string("0"), [](std::string accumulated, int const i)
+            {
+                return accumulated += std::to_string(i);
+            });
+
+            THEN("The accumulator is applied to every element in order")
+            {
+                REQUIRE(20 == sum);
+                REQUIRE("01234" == joined);
+            }
+        }
+
+        WHEN("The elements are aggregated with a result selector")
+        {
+            auto product = collection.Aggregate(
+                1,
+                std::multiplies<>(),
+                [](int const accumulated) { return std::to_string(accumulated); });
+
+            THEN("The final accumulated value is projected")
+            {
+                REQUIRE("24" == product);
+            }
+        }
+    }
+
+    GIVEN("An empty collection")
+    {
+        auto collection = CLinqCollection<int>::Empty();
+
+        THEN("The seed is returned")
+        {
+            REQUIRE(5 == collection.Aggregate(5, std::plus<>()));
+        }
+    }
+}
+
 SCENARIO("CLinqCollections can have values appended")
 {
     GIVEN("A collection and a value")
@@ -534,6 +591,24 @@ SCENARIO("CLinqCollections can be projected to maps")
     }
 }
 
+SCENARIO("CLinqCollections can be projected to sets")
+{
+    GIVEN("A collection with repeated elements")
+    {
+        auto const collection = CLinqCollection<int>({ 3, 1, 2, 3, 1 });
+
+        WHEN("Projected to a set")
+        {
+            auto const set = collection.ToSet();
+
+            THEN("The distinct elements are ordered")
+            {
+                REQUIRE(std::set<int>{ 1, 2, 3 } == set);
+            }
+        }
+    }
+}
+
 SCENARIO("CLinqCollection elements can be projected to a new sequence")
 {
     GIVEN("A collection and projection function")
@@ -554,6 +629,51 @@ SCENARIO("CLinqCollection elements can be projected to a new sequence")
     }
 }
 
+SCENARIO("CLinqCollection elements can be projected to sequences and flattened")
+{
+    GIVEN("A collection of users with lists of events")
+    {
+        using User = std::pair<std::string, std::vector<int>>;
+        auto collection = CLinqCollection<User>({ { "ann", { 1, 2 } }, { "bob", {} }, { "cal", { 3, 4, 5 } } });
+
+        WHEN("The events are flattened")
+        {
+            auto events = collection.SelectMany([](User const& user) -> std::vector<int> const& { return user.second; });
+
+            THEN("Every event is in the result, in order")
+            {
+                REQUIRE(std::vector<int>{ 1, 2, 3, 4, 5 } == events.ToVector());
+            }
+        }
+
+        WHEN("The events are flattened with a result selector")
+        {
+            auto events = collection.SelectMany(
+                [](User const& user) -> std::vector<int> const& { return user.second; },
+                [](User const& user, int const event) { return user.first + std::to_string(event); });
+
+            THEN("Each event is projected with its user")
+            {
+                REQUIRE(std::vector<std::string>{ "ann1", "ann2", "cal3", "cal4", "cal5" } == events.ToVector());
+            }
+        }
+
+        WHEN("Each element is projected to a temporary sequence")
+        {
+            auto names = collection.SelectMany([](User const& user)
+            {
+                return std::vector<std::string>(user.second.size(), user.first);
+            });
+
+            THEN("The temporary sequences are flattened")
+            {
+                REQUIRE(std::vector<std::string>{ "ann", "ann", "cal", "cal", "cal" } == names.ToVector());
+                REQUIRE(collection.AsQuery().SelectMany([](User const& user) { return std::vector<std::string>(user.second.size(), user.first); }).ToVector() == names.ToVector());
+            }
+        }
+    }
+}
+
 SCENARIO("CLinqCollection elements can be filtered to a new sequence")
 {
     GIVEN("A collection and filter function")
@@ -908,4 +1028,912 @@ SCENARIO("CLinqCollections can have elements omitted")
             }
         }
     }
-}
\ No newline at end of file
+}
+SCENARIO("CLinqCollections accept any callable for match and projection functions")
+{
+    GIVEN("A collection")
+    {
+        struct Point { int x; int y; };
+        auto collection = CLinqCollection<Point>(std::vector<Point>{ { 1, 2 }, { 3, 4 }, { 5, 6 } });
+        auto threshold = 2;
+        auto matchFunction = [threshold](Point const& point) { return point.x > threshold; };
+
+        WHEN("Capturing lambdas are used as match functions")
+        {
+            THEN("The expected results are returned")
+            {
+                REQUIRE(collection.Any(matchFunction));
+                REQUIRE_FALSE(collection.All(matchFunction));
+                REQUIRE(2 == collection.Count(matchFunction));
+                REQUIRE(2 == collection.Where(matchFunction).Count());
+                REQUIRE(5 == collection.SkipWhile([](Point const& point) { return point.x < 5; }).First().x);
+                REQUIRE(1 == collection.TakeWhile([](Point const& point) { return point.x < 3; }).Count());
+            }
+        }
+
+        WHEN("Elements are projected without specifying the projected type")
+        {
+            auto projectedCollection = collection.Select([](Point const& point) { return point.x + point.y; });
+
+            THEN("The projected type is deduced")
+            {
+                REQUIRE(CLinqCollection<int>({ 3, 7, 11 }) == projectedCollection);
+            }
+        }
+
+        WHEN("Elements are projected with a pointer to member")
+        {
+            auto projectedCollection = collection.Select(&Point::y);
+
+            THEN("The members are projected")
+            {
+                REQUIRE(CLinqCollection<int>({ 2, 4, 6 }) == projectedCollection);
+            }
+        }
+
+        WHEN("Elements are filtered with a std::function")
+        {
+            auto function = CLinqCollection<Point>::MatchFunction(matchFunction);
+
+            THEN("The expected collection is returned")
+            {
+                REQUIRE(2 == collection.Where(function).Count());
+            }
+        }
+    }
+}
+SCENARIO("CLinqCollection set operations preserve order of first appearance")
+{
+    GIVEN("Collections with duplicate elements")
+    {
+        auto collection1 = CLinqCollection<int>({ 3, 1, 3, 2, 1 });
+        auto collection2 = CLinqCollection<int>({ 4, 2, 4, 5 });
+
+        THEN("The expected collections are returned")
+        {
+            REQUIRE(CLinqCollection<int>({ 3, 1, 2 }) == collection1.Distinct());
+            REQUIRE(CLinqCollection<int>({ 3, 1, 3, 1 }) == collection1.Except(collection2));
+            REQUIRE(CLinqCollection<int>({ 2 }) == collection1.Intersection(collection2));
+            REQUIRE(CLinqCollection<int>({ 3, 1, 2, 4, 5 }) == collection1.Union(collection2));
+        }
+    }
+
+    GIVEN("A collection of elements that cannot be hashed")
+    {
+        struct Element
+        {
+            int value;
+
+            auto operator<=>(Element const&) const = default;
+        };
+
+        auto collection = CLinqCollection<Element>(std::vector<Element>{ { 2 }, { 1 }, { 2 } });
+
+        THEN("Distinct elements are returned")
+        {
+            REQUIRE(CLinqCollection<Element>(std::vector<Element>{ { 2 }, { 1 } }) == collection.Distinct());
+        }
+    }
+}
+SCENARIO("Temporary CLinqCollections are transformed in place")
+{
+    GIVEN("A collection that is moved into a chain of operators")
+    {
+        auto collection = CLinqCollection<int>({ 1, 2, 3, 4, 5, 6 });
+        auto const* storage = &collection[0];
+
+        WHEN("The chain filters and truncates the collection")
+        {
+            auto actual = std::move(collection)
+                .Where([](int const i) { return i % 2 == 0; })
+                .SkipWhile([](int const i) { return i < 4; })
+                .Reverse()
+                .Take(1);
+
+            THEN("The expected collection is returned in the original storage")
+            {
+                REQUIRE(CLinqCollection<int>({ 6 }) == actual);
+                REQUIRE(storage == &actual[0]);
+            }
+        }
+
+        WHEN("The chain adds elements to the collection")
+        {
+            auto actual = (std::move(collection).Skip(2).SkipLast(2).Append(7).Prepend(0) + CLinqCollection<int>({ 8 }))
+                .TakeLast(4)
+                .TakeWhile([](int const i) { return i < 8; });
+
+            THEN("The expected collection is returned")
+            {
+                REQUIRE(CLinqCollection<int>({ 3, 4, 7 }) == actual);
+            }
+        }
+
+        WHEN("The collection is concatenated with itself")
+        {
+            auto actual = std::move(collection) + collection;
+
+            THEN("Its elements are repeated")
+            {
+                REQUIRE(CLinqCollection<int>({ 1, 2, 3, 4, 5, 6, 1, 2, 3, 4, 5, 6 }) == actual);
+            }
+        }
+    }
+
+    GIVEN("A temporary collection")
+    {
+        THEN("Operators that cannot be applied throw")
+        {
+            REQUIRE_THROWS_AS(CLinqCollection<int>({ 1 }).Take(2), CLinqException);
+            REQUIRE_THROWS_AS(CLinqCollection<int>({ 1 }).Skip(2), CLinqException);
+        }
+    }
+}
+SCENARIO("CLinqCollections can take ownership of their elements")
+{
+    GIVEN("A vector of strings")
+    {
+        auto values = std::vector<std::string>{ "hello", "world" };
+        auto const* storage = values.data();
+
+        WHEN("A collection is constructed by moving the vector")
+        {
+            auto collection = CLinqCollection<std::string>(std::move(values));
+
+            THEN("The storage of the vector is reused")
+            {
+                REQUIRE(storage == &collection[0]);
+            }
+
+            THEN("The elements can be moved out of the collection")
+            {
+                auto elements = std::move(collection).ToVector();
+
+                REQUIRE(storage == elements.data());
+                REQUIRE(std::vector<std::string>{ "hello", "world" } == elements);
+            }
+        }
+    }
+}
+SCENARIO("CLinqCollections can be aggregated")
+{
+    GIVEN("An empty collection")
+    {
+        auto collection = CLinqCollection<int>();
+
+        THEN("The sum is zero and other aggregates throw")
+        {
+            REQUIRE(0 == collection.Sum());
+            REQUIRE_THROWS_AS(collection.Min(), CLinqException);
+            REQUIRE_THROWS_AS(collection.Max(), CLinqException);
+            REQUIRE_THROWS_AS(collection.Average(), CLinqException);
+            REQUIRE_THROWS_AS(collection.MinBy([](int const i) { return i; }), CLinqException);
+        }
+    }
+
+    GIVEN("Collections of arithmetic elements large enough to be vectorised")
+    {
+        auto integers = CLinqCollection<int>::Range(-500, 1003).Select([](int const i) { return (i * 37) % 1001; });
+        auto longs = integers.StaticCast<std::int64_t>();
+        auto doubles = integers.Select([](int const i) { return i * 0.5; });
+        auto floats = integers.Select([](int const i) { return static_cast<float>(i) * 0.25f; });
+        auto expectedSum = 0;
+        auto expectedMin = integers[0];
+        auto expectedMax = integers[0];
+
+        for (auto const i : integers)
+        {
+            expectedSum += i;
+            expectedMin = std::min(expectedMin, i);
+            expectedMax = std::max(expectedMax, i);
+        }
+
+        THEN("The aggregates match a sequential evaluation")
+        {
+            REQUIRE(expectedSum == integers.Sum());
+            REQUIRE(expectedSum == longs.Sum());
+            REQUIRE(expectedSum * 0.5 == doubles.Sum());
+            REQUIRE(expectedSum * 0.25f == floats.Sum());
+            REQUIRE(expectedMin == integers.Min());
+            REQUIRE(expectedMax == integers.Max());
+            REQUIRE(expectedMin * 0.5 == doubles.Min());
+            REQUIRE(expectedMax * 0.25f == floats.Max());
+            REQUIRE(expectedSum / 1003.0 == Approx(integers.Average()));
+            REQUIRE(expectedSum / 2006.0 == Approx(doubles.Average()));
+            REQUIRE(expectedSum / 4012.0 == Approx(floats.Average()));
+            REQUIRE(expectedSum / 1003.0 == Approx(longs.Average()));
+        }
+    }
+
+    GIVEN("Collections whose sums do not fit in their element type")
+    {
+        auto const integers = CLinqCollection<std::int32_t>::Repeat(std::numeric_limits<std::int32_t>::max(), 100);
+        auto const floats = CLinqCollection<float>::Repeat(1.0f, 63).Prepend(16777216.0f);
+
+        THEN("The average is computed with a wider sum")
+        {
+            REQUIRE(static_cast<double>(std::numeric_limits<std::int32_t>::max()) == integers.Average());
+            REQUIRE((16777216.0 + 63.0) / 64.0 == floats.Average());
+        }
+    }
+
+    GIVEN("A collection of non-arithmetic elements")
+    {
+        auto collection = CLinqCollection<std::string>(std::vector<std::string>{ "b", "ccc", "a", "dd" });
+        auto length = [](std::string const& s) { return s.size(); };
+
+        THEN("Elements are aggregated with their operators")
+        {
+            REQUIRE("bcccadd" == collection.Sum());
+            REQUIRE("a" == collection.Min());
+            REQUIRE("dd" == collection.Max());
+        }
+
+        THEN("Projections of the elements are aggregated")
+        {
+            REQUIRE(7 == collection.Sum(length));
+            REQUIRE(1 == collection.Min(length));
+            REQUIRE(3 == collection.Max(length));
+            REQUIRE(1.75 == collection.Average(length));
+        }
+
+        THEN("The first element with the least or greatest key is returned")
+        {
+            REQUIRE("b" == collection.MinBy(length));
+            REQUIRE("ccc" == collection.MaxBy(length));
+        }
+    }
+}
+
+SCENARIO("CLinqCollections propagate their allocator")
+{
+    GIVEN("A collection using a polymorphic allocator")
+    {
+        auto resource = std::pmr::monotonic_buffer_resource();
+        auto const allocator = std::pmr::polymorphic_allocator<int>(&resource);
+        auto const collection = CLinqCollection<int, std::pmr::polymorphic_allocator<int>>({ 1, 2, 3, 4 }, allocator);
+
+        WHEN("The collection is transformed")
+        {
+            auto const evens = collection.Where([](int const x) { return x % 2 == 0; });
+            auto const halves = collection.Select([](int const x) { return x / 2.0; });
+            auto const appended = collection.Append(5);
+
+            THEN("The results use the same allocator")
+            {
+                REQUIRE(&resource == evens.get_allocator().resource());
+                REQUIRE(&resource == halves.get_allocator().resource());
+                REQUIRE(&resource == appended.get_allocator().resource());
+                REQUIRE(std::vector<double>{ 0.5, 1, 1.5, 2 } == std::vector<double>(halves.cbegin(), halves.cend()));
+            }
+        }
+    }
+}
+
+SCENARIO("CLinqCollections can be ordered")
+{
+    GIVEN("A collection of integers")
+    {
+        auto const collection = CLinqCollection<int>({ 3, -1, 4, -1, 5, -9, 2, 6 });
+        auto const identity = [](int const x) { return x; };
+
+        THEN("The collection can be ordered by ascending or descending key")
+        {
+            REQUIRE(CLinqCollection<int>({ -9, -1, -1, 2, 3, 4, 5, 6 }) == collection.OrderBy(identity));
+            REQUIRE(CLinqCollection<int>({ 6, 5, 4, 3, 2, -1, -1, -9 }) == collection.OrderByDescending(identity));
+            REQUIRE(CLinqCollection<int>() == CLinqCollection<int>().OrderBy(identity));
+        }
+    }
+
+    GIVEN("A collection of doubles")
+    {
+        auto const infinity = std::numeric_limits<double>::infinity();
+        auto const collection = CLinqCollection<double>({ 0.5, -0.0, -2.5, infinity, 0.0, -infinity, 1e-300, -1e300 });
+        auto const identity = [](double const x) { return x; };
+
+        THEN("Negative numbers, zeros and infinities are ordered as they compare")
+        {
+            auto const ordered = collection.OrderBy(identity);
+
+            REQUIRE(std::vector<double>{ -infinity, -1e300, -2.5, 0.0, 0.0, 1e-300, 0.5, infinity } == ordered.ToVector());
+            REQUIRE(std::signbit(ordered[3]));
+            REQUIRE_FALSE(std::signbit(ordered[4]));
+        }
+    }
+
+    GIVEN("A collection of strings")
+    {
+        auto const collection = CLinqCollection<std::string>({ "pear", "fig", "apple", "kiwi", "date", "plum", "lime" });
+        auto const length = [](std::string const& x) { return x.size(); };
+        auto const text = [](std::string const& x) { return x; };
+
+        THEN("Ties can be broken by subsequent keys")
+        {
+            REQUIRE(CLinqCollection<std::string>({ "fig", "pear", "kiwi", "date", "plum", "lime", "apple" }) == collection.OrderBy(length));
+            REQUIRE(CLinqCollection<std::string>({ "fig", "date", "kiwi", "lime", "pear", "plum", "apple" }) == collection.OrderBy(length).ThenBy(text));
+            REQUIRE(CLinqCollection<std::string>({ "apple", "plum", "pear", "lime", "kiwi", "date", "fig" }) == collection.OrderByDescending(length).ThenByDescending(text));
+            REQUIRE(CLinqCollection<std::string>({ "apple", "date", "fig", "kiwi", "lime", "pear", "plum" }) == collection.OrderBy(text).ThenBy(length));
+        }
+    }
+
+    GIVEN("A large collection with many equal keys")
+    {
+        auto elements = std::vector<std::pair<std::int64_t, int>>();
+        for (auto i = 0; i < 5000; ++i)
+        {
+            elements.emplace_back((i * 7919) % 97 - 48, i);
+        }
+
+        auto const collection = CLinqCollection<std::pair<std::int64_t, int>>(elements);
+        auto keyCount = 0;
+        auto const key = [&keyCount](std::pair<std::int64_t, int> const& x) { ++keyCount; return x.first; };
+
+        WHEN("The collection is ordered")
+        {
+            auto const ordered = collection.OrderByDescending(key);
+            std::stable_sort(elements.begin(), elements.end(), [](auto const& left, auto const& right) { return left.first > right.first; });
+
+            THEN("The sort is stable and each key is computed once")
+            {
+                REQUIRE(elements == ordered.ToVector());
+                REQUIRE(5000 == keyCount);
+            }
+        }
+
+        WHEN("The collection is ordered by several keys")
+        {
+            auto const parity = [](std::pair<std::int64_t, int> const& x) { return x.second % 2 == 0; };
+            auto const ordered = CLinqCollection<std::pair<std::int64_t, int>>(collection)
+                .OrderBy(key)
+                .ThenByDescending(parity)
+                .ThenBy([](std::pair<std::int64_t, int> const& x) { return -x.second; });
+
+            std::sort(elements.begin(), elements.end(), [](auto const& left, auto const& right)
+            {
+                return std::tuple(left.first, right.second % 2 == 0, -left.second) <
+                    std::tuple(right.first, left.second % 2 == 0, -right.second);
+            });
+
+            THEN("Each key breaks the ties of the keys before it")
+            {
+                REQUIRE(elements == ordered.ToVector());
+            }
+        }
+    }
+
+    GIVEN("A large collection of floats of both signs")
+    {
+        auto elements = std::vector<float>();
+        for (auto i = 0; i < 100000; ++i)
+        {
+            auto const value = static_cast<float>((i * 7919) % 100003) / 7.0f;
+            elements.push_back(i % 3 == 0 ? -value : value);
+        }
+
+        auto const collection = CLinqCollection<float>(elements);
+
+        WHEN("The collection is ordered")
+        {
+            auto const ascending = collection.OrderBy([](float const x) { return x; });
+            auto const descending = collection.OrderByDescending([](float const x) { return x; });
+
+            THEN("The elements are ordered as a comparison sort orders them")
+            {
+                std::ranges::stable_sort(elements);
+                REQUIRE(elements == ascending.ToVector());
+
+                std::ranges::stable_sort(elements, std::greater<>());
+                REQUIRE(elements == descending.ToVector());
+            }
+        }
+    }
+}
+
+SCENARIO("CLinqCollections can take the elements with the least or greatest keys")
+{
+    GIVEN("A collection of strings")
+    {
+        auto const collection = CLinqCollection<std::string>({ "pear", "fig", "banana", "kiwi", "apple", "plum" });
+        auto const length = [](std::string const& x) { return x.size(); };
+
+        WHEN("The elements with the least and greatest keys are taken")
+        {
+            auto const least = collection.TopBy(length, 3);
+            auto const greatest = collection.TopByDescending(length, 2);
+
+            THEN("The elements are taken in order of key, and ties keep their order")
+            {
+                REQUIRE(CLinqCollection<std::string>({ "fig", "pear", "kiwi" }) == least);
+                REQUIRE(CLinqCollection<std::string>({ "banana", "apple" }) == greatest);
+            }
+        }
+
+        WHEN("The elements are moved out of the collection")
+        {
+            auto const least = CLinqCollection<std::string>(collection).TopBy([](std::string const& x) { return x; }, 2);
+
+            THEN("The elements with the least keys are taken")
+            {
+                REQUIRE(CLinqCollection<std::string>({ "apple", "banana" }) == least);
+            }
+        }
+
+        WHEN("No elements or every element is taken")
+        {
+            THEN("The result matches OrderBy followed by Take")
+            {
+                REQUIRE_FALSE(collection.TopBy(length, 0).Any());
+                REQUIRE(collection.OrderByDescending(length).ToVector() == collection.TopByDescending(length, 6).ToVector());
+            }
+        }
+
+        WHEN("More elements are taken than exist in the collection")
+        {
+            THEN("An exception is thrown")
+            {
+                REQUIRE_THROWS_AS(collection.TopBy(length, 7), CLinqException);
+            }
+        }
+    }
+
+    GIVEN("A collection whose keys count their copies")
+    {
+        struct CountedKey
+        {
+            CountedKey(int const value, int* const copies) : value(value), copies(copies) {}
+            CountedKey(CountedKey const& key) : value(key.value), copies(key.copies) { ++*copies; }
+            CountedKey(CountedKey&&) = default;
+            CountedKey& operator=(CountedKey const&) = default;
+            CountedKey& operator=(CountedKey&&) = default;
+            bool operator<(CountedKey const& key) const { return value < key.value; }
+
+            int value;
+            int* copies;
+        };
+
+        auto copies = 0;
+        auto const collection = CLinqCollection<int>::Range(0, 1000);
+
+        WHEN("The elements with the least keys are taken")
+        {
+            auto const least = collection.TopBy([&copies](int const x) { return CountedKey(x, &copies); }, 10);
+
+            THEN("Only the keys of selected elements are copied")
+            {
+                REQUIRE(CLinqCollection<int>::Range(0, 10) == least);
+                REQUIRE(copies <= 10);
+            }
+        }
+    }
+
+    GIVEN("A large collection with many equal keys")
+    {
+        auto elements = std::vector<std::pair<int, int>>();
+        for (auto i = 0; i < 10000; ++i)
+        {
+            elements.emplace_back((i * 7919) % 101 - 50, i);
+        }
+
+        auto const collection = CLinqCollection<std::pair<int, int>>(elements);
+        auto const key = [](std::pair<int, int> const& x) { return x.first; };
+        auto const keyOfDouble = [](std::pair<int, int> const& x) { return x.first * 0.5; };
+
+        WHEN("Few and many elements are taken")
+        {
+            THEN("The result matches OrderBy followed by Take")
+            {
+                for (auto const count : { 1, 10, 99, 100, 101, 600, 5000 })
+                {
+                    auto const numberOfElements = static_cast<std::size_t>(count);
+
+                    REQUIRE(collection.OrderBy(key).Take(numberOfElements) == collection.TopBy(key, numberOfElements));
+                    REQUIRE(collection.OrderByDescending(key).Take(numberOfElements) == collection.TopByDescending(key, numberOfElements));
+                    REQUIRE(collection.OrderByDescending(keyOfDouble).Take(numberOfElements) == collection.TopByDescending(keyOfDouble, numberOfElements));
+                    REQUIRE(collection.AsQuery().TopBy(key, numberOfElements).ToCollection() == collection.TopBy(key, numberOfElements));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("CLinqCollections can be joined")
+{
+    GIVEN("Collections of orders and customers")
+    {
+        struct Customer
+        {
+            int id;
+            std::string name;
+        };
+
+        struct Order
+        {
+            int customerId;
+            int total;
+        };
+
+        auto const customers = CLinqCollection<Customer>({ { 1, "Ada" }, { 2, "Brian" }, { 3, "Claude" }, { 2, "Bjarne" } });
+        auto const orders = CLinqCollection<Order>({ { 2, 10 }, { 1, 20 }, { 4, 30 }, { 2, 40 }, { 1, 50 }, { 2, 60 } });
+        auto const customerIdOfOrder = [](Order const& x) { return x.customerId; };
+        auto const idOfCustomer = [](Customer const& x) { return x.id; };
+        auto const describe = [](Order const& order, Customer const& customer) { return customer.name + ":" + std::to_string(order.total); };
+
+        auto const expected = std::vector<std::string>{
+            "Brian:10", "Bjarne:10", "Ada:20", "Brian:40", "Bjarne:40", "Ada:50", "Brian:60", "Bjarne:60" };
+
+        WHEN("The larger collection is joined with the smaller")
+        {
+            auto const joined = orders.Join(customers, customerIdOfOrder, idOfCustomer, describe);
+
+            THEN("The results are ordered by the outer and then the inner elements")
+            {
+                REQUIRE(expected == joined.ToVector());
+            }
+        }
+
+        WHEN("The smaller collection is joined with the larger")
+        {
+            auto const joined = customers.Join(orders, idOfCustomer, customerIdOfOrder,
+                [](Customer const& customer, Order const& order) { return customer.name + ":" + std::to_string(order.total); });
+
+            THEN("The results are ordered by the outer and then the inner elements")
+            {
+                REQUIRE(std::vector<std::string>{ "Ada:20", "Ada:50", "Brian:10", "Brian:40", "Brian:60", "Bjarne:10", "Bjarne:40", "Bjarne:60" }
+                    == joined.ToVector());
+            }
+        }
+
+        WHEN("A lookup of the inner collection is reused")
+        {
+            auto const customersById = customers.GroupBy(idOfCustomer);
+            auto const joined = orders.Join(customersById, customerIdOfOrder, describe);
+            auto const grouped = orders.GroupJoin(customersById, customerIdOfOrder,
+                [](Order const& order, CLinqView<Customer> const matches) { return order.total + static_cast<int>(matches.Count()); });
+
+            THEN("The results are the same as joining the collection")
+            {
+                REQUIRE(expected == joined.ToVector());
+                REQUIRE(std::vector<int>{ 12, 21, 30, 42, 51, 62 } == grouped.ToVector());
+            }
+        }
+
+        WHEN("The collections are group joined")
+        {
+            auto const grouped = customers.GroupJoin(orders, idOfCustomer, customerIdOfOrder,
+                [](Customer const& customer, CLinqView<Order> const matches)
+                {
+                    return customer.name + ":" + std::to_string(matches.Sum([](Order const& x) { return x.total; }));
+                });
+
+            THEN("There is one result for each outer element")
+            {
+                REQUIRE(std::vector<std::string>{ "Ada:70", "Brian:110", "Claude:0", "Bjarne:110" } == grouped.ToVector());
+            }
+        }
+    }
+
+    GIVEN("Large collections with many matches")
+    {
+        auto const left = CLinqCollection<int>::Range(0, 300);
+        auto const right = CLinqCollection<int>::Range(0, 1000);
+        auto const pair = [](int const x, int const y) { return std::pair<int, int>(x, y); };
+
+        WHEN("They are joined in either order")
+        {
+            auto const leftFirst = left.Join(right, [](int const x) { return x % 7; }, [](int const y) { return y % 7; }, pair);
+            auto const rightFirst = right.Join(left, [](int const y) { return y % 7; }, [](int const x) { return x % 7; }, pair);
+
+            THEN("The results match a nested loop join")
+            {
+                auto expectedLeftFirst = std::vector<std::pair<int, int>>();
+                auto expectedRightFirst = std::vector<std::pair<int, int>>();
+                for (auto x = 0; x < 300; ++x)
+                {
+                    for (auto y = 0; y < 1000; ++y)
+                    {
+                        if (x % 7 == y % 7)
+                        {
+                            expectedLeftFirst.emplace_back(x, y);
+                        }
+                    }
+                }
+
+                for (auto y = 0; y < 1000; ++y)
+                {
+                    for (auto x = 0; x < 300; ++x)
+                    {
+                        if (x % 7 == y % 7)
+                        {
+                            expectedRightFirst.emplace_back(y, x);
+                        }
+                    }
+                }
+
+                REQUIRE(expectedLeftFirst == leftFirst.ToVector());
+                REQUIRE(expectedRightFirst == rightFirst.ToVector());
+            }
+        }
+    }
+}
+SCENARIO("CLinqCollections can be zipped")
+{
+    GIVEN("Collections of different lengths")
+    {
+        auto const numbers = CLinqCollection<int>({ 1, 2, 3, 4 });
+        auto const words = CLinqCollection<std::string>({ "one", "two", "three" });
+
+        WHEN("They are zipped into tuples")
+        {
+            auto const zipped = numbers.Zip(words);
+
+            THEN("The result is as long as the shorter collection")
+            {
+                REQUIRE(std::vector<std::tuple<int, std::string>>{ { 1, "one" }, { 2, "two" }, { 3, "three" } } == zipped.ToVector());
+            }
+        }
+
+        WHEN("They are zipped with a result selector")
+        {
+            auto const zipped = numbers.Zip(words, [](int const x, std::string const& y) { return y + ":" + std::to_string(x); });
+
+            THEN("The selector is applied to each pair")
+            {
+                REQUIRE(std::vector<std::string>{ "one:1", "two:2", "three:3" } == zipped.ToVector());
+            }
+        }
+
+        WHEN("One of them is empty")
+        {
+            auto const zipped = numbers.Zip(CLinqCollection<int>(), std::plus<>());
+
+            THEN("The result is empty")
+            {
+                REQUIRE_FALSE(zipped.Any());
+            }
+        }
+    }
+
+    GIVEN("Collections of arithmetic elements")
+    {
+        auto const check = []<typename T>(CLinqCollection<T> const& left, CLinqCollection<T> const& right, auto const operation)
+        {
+            auto const zipped = left.Zip(right, operation);
+            auto expected = std::vector<T>();
+            for (auto i = std::size_t{ 0 }; i < std::min(left.Count(), right.Count()); ++i)
+            {
+                expected.push_back(operation(left[i], right[i]));
+            }
+
+            return expected == zipped.ToVector();
+        };
+
+        auto const checkAll = [&check]<typename T>(CLinqCollection<T> const& left, CLinqCollection<T> const& right)
+        {
+            return check(left, right, std::plus<>())
+                && check(left, right, std::multiplies<>())
+                && check(left, right, CLinqMinimum())
+                && check(left, right, CLinqMaximum());
+        };
+
+        WHEN("They are zipped with arithmetic operators")
+        {
+            auto const left = CLinqCollection<int>::Range(-500, 1003);
+            auto const right = CLinqCollection<int>::Range(0, 1011).Select([](int const x) { return (x * 7919) % 1013 - 506; });
+
+            THEN("The results match applying the operator to each pair")
+            {
+                REQUIRE(checkAll(left, right));
+                REQUIRE(checkAll(left.StaticCast<long long>(), right.StaticCast<long long>()));
+                REQUIRE(checkAll(left.StaticCast<float>(), right.StaticCast<float>()));
+                REQUIRE(checkAll(left.StaticCast<double>(), right.StaticCast<double>()));
+                REQUIRE(checkAll(right.Take(5), left.Take(7)));
+            }
+        }
+    }
+}
+
+SCENARIO("CLinqCollections can be chunked")
+{
+    GIVEN("A collection")
+    {
+        auto const collection = CLinqCollection<int>::Range(1, 1030);
+
+        WHEN("It is chunked into pieces which do not divide it evenly")
+        {
+            auto const chunks = collection.Chunk(512);
+
+            THEN("Every chunk but the last is full and views the collection in order")
+            {
+                REQUIRE(3 == chunks.Count());
+                REQUIRE(std::vector<std::size_t>{ 512, 512, 6 } == chunks.Select([](CLinqView<int> const chunk) { return chunk.Count(); }).ToVector());
+                REQUIRE(collection.AsView().Data() == chunks.First().Data());
+                REQUIRE(collection.AsView().Skip(1024) == chunks.Last());
+                REQUIRE(collection.Sum() == chunks.Sum([](CLinqView<int> const chunk) { return chunk.Sum(); }));
+            }
+        }
+
+        WHEN("It is chunked into pieces larger than itself")
+        {
+            auto const chunks = collection.Chunk(4096);
+
+            THEN("There is a single chunk")
+            {
+                REQUIRE(1 == chunks.Count());
+                REQUIRE(collection.AsView() == chunks.Single());
+            }
+        }
+
+        WHEN("It is chunked into pieces of size 0")
+        {
+            THEN("Exception is thrown")
+            {
+                REQUIRE_THROWS_AS(collection.Chunk(0), CLinqException);
+            }
+        }
+    }
+
+    GIVEN("An empty collection")
+    {
+        auto const collection = CLinqCollection<int>();
+
+        WHEN("It is chunked")
+        {
+            auto const chunks = collection.Chunk(3);
+
+            THEN("There are no chunks")
+            {
+                REQUIRE_FALSE(chunks.Any());
+            }
+        }
+    }
+}
+
+SCENARIO("CLinqCollections can be aggregated over sliding windows")
+{
+    GIVEN("A collection")
+    {
+        auto const collection = CLinqCollection<int>({ 5, 1, 4, 4, 2, 8, 3, 3, 7 });
+
+        WHEN("It is split into windows")
+        {
+            auto const windows = collection.Window(4, 2);
+
+            THEN("Each whole window views the collection")
+            {
+                REQUIRE(3 == windows.Count());
+                REQUIRE(collection.AsView().Skip(2).Take(4) == windows[1]);
+                REQUIRE(collection.AsView().Skip(4).Take(4) == windows.Last());
+            }
+        }
+
+        WHEN("Windows are aggregated")
+        {
+            THEN("Each window is aggregated in order")
+            {
+                REQUIRE(std::vector<int>{ 10, 9, 10, 14, 13, 14, 13 } == collection.WindowSum(3).ToVector());
+                REQUIRE(std::vector<double>{ 3.5, 4.5, 4.0 } == collection.WindowAverage(4, 2).ToVector());
+                REQUIRE(std::vector<int>{ 1, 1, 2, 2, 2, 3, 3 } == collection.WindowMin(3).ToVector());
+                REQUIRE(std::vector<int>{ 5, 4, 4, 8, 8, 8, 7 } == collection.WindowMax(3).ToVector());
+                REQUIRE(std::vector<int>{ 5, 8 } == collection.WindowMax(2, 4).ToVector());
+                REQUIRE(std::vector<int>{ 1 } == collection.WindowMin(9).ToVector());
+            }
+        }
+
+        WHEN("The windows are larger than the collection")
+        {
+            THEN("There are no windows")
+            {
+                REQUIRE_FALSE(collection.Window(10).Any());
+                REQUIRE_FALSE(collection.WindowSum(10).Any());
+                REQUIRE_FALSE(collection.WindowMin(10).Any());
+            }
+        }
+
+        WHEN("The window size or step is 0")
+        {
+            THEN("Exception is thrown")
+            {
+                REQUIRE_THROWS_AS(collection.Window(0), CLinqException);
+                REQUIRE_THROWS_AS(collection.WindowSum(3, 0), CLinqException);
+                REQUIRE_THROWS_AS(collection.WindowAverage(0), CLinqException);
+                REQUIRE_THROWS_AS(collection.WindowMax(0, 1), CLinqException);
+            }
+        }
+    }
+
+    GIVEN("A long series")
+    {
+        auto const series = CLinqCollection<int>::Range(0, 5000).Select([](int const x) { return (x * 7919) % 1009 - 500; });
+        auto const samples = series.Select([](int const x) { return x * 0.1; });
+
+        WHEN("It is aggregated over windows of different sizes and steps")
+        {
+            THEN("The results match aggregating each window separately")
+            {
+                for (auto const& [windowSize, step] : { std::pair<std::size_t, std::size_t>{ 1, 1 }, { 60, 1 }, { 60, 7 }, { 7, 60 }, { 999, 13 } })
+                {
+                    auto const windows = series.Window(windowSize, step);
+                    auto const sampleWindows = samples.Window(windowSize, step);
+
+                    REQUIRE(windows.Select([](CLinqView<int> const window) { return window.Sum(); }).ToVector() == series.WindowSum(windowSize, step).ToVector());
+                    REQUIRE(windows.Select([](CLinqView<int> const window) { return window.Min(); }).ToVector() == series.WindowMin(windowSize, step).ToVector());
+                    REQUIRE(windows.Select([](CLinqView<int> const window) { return window.Max(); }).ToVector() == series.WindowMax(windowSize, step).ToVector());
+
+                    auto const averages = samples.WindowAverage(windowSize, step);
+                    auto const sums = samples.WindowSum(windowSize, step);
+                    REQUIRE(sampleWindows.Count() == averages.Count());
+
+                    for (std::size_t i = 0; i < averages.Count(); ++i)
+                    {
+                        REQUIRE(std::abs(sampleWindows[i].Average() - averages[i]) < 1e-9);
+                        REQUIRE(std::abs(sampleWindows[i].Sum() - sums[i]) < 1e-9 * static_cast<double>(windowSize));
+                    }
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("CLinqCollections can be scanned")
+{
+    GIVEN("A collection")
+    {
+        auto const collection = CLinqCollection<int>({ 3, 1, 4, 1, 5 });
+
+        WHEN("It is scanned")
+        {
+            THEN("The running results include or exclude each element")
+            {
+                REQUIRE(std::vector<int>{ 13, 14, 18, 19, 24 } == collection.Scan(10, std::plus<>()).ToVector());
+                REQUIRE(std::vector<int>{ 10, 13, 14, 18, 19 } == collection.ExclusiveScan(10, std::plus<>()).ToVector());
+                REQUIRE(std::vector<int>{ 3, 3, 4, 4, 5 } == collection.Scan(0, CLinqMaximum()).ToVector());
+                REQUIRE(std::vector<std::string>{ "3", "31", "314", "3141", "31415" }
+                    == collection.Scan(std::string(), [](std::string const& x, int const y) { return x + std::to_string(y); }).ToVector());
+            }
+        }
+
+        WHEN("An empty collection is scanned")
+        {
+            THEN("There are no results")
+            {
+                REQUIRE_FALSE(CLinqCollection<int>().Scan(0, std::plus<>()).Any());
+                REQUIRE_FALSE(CLinqCollection<int>().ExclusiveScan(0, std::plus<>()).Any());
+            }
+        }
+    }
+
+    GIVEN("Collections of arithmetic elements")
+    {
+        auto const check = []<typename T>(CLinqCollection<T> const& collection, T const seed)
+        {
+            auto expected = std::vector<T>();
+            auto sum = seed;
+            for (auto const element : collection.AsView())
+            {
+                expected.push_back(sum);
+                sum += element;
+            }
+
+            auto exclusive = collection.ExclusiveScan(seed, std::plus<>()).ToVector();
+            auto inclusive = collection.Scan(seed, std::plus<>()).ToVector();
+            expected.push_back(sum);
+
+            return std::vector<T>(expected.begin(), expected.end() - 1) == exclusive
+                && std::vector<T>(expected.begin() + 1, expected.end()) == inclusive;
+        };
+
+        WHEN("They are summed")
+        {
+            auto const collection = CLinqCollection<int>::Range(0, 1003).Select([](int const x) { return (x * 7919) % 1013 - 506; });
+
+            THEN("The results match a sequential scan")
+            {
+                REQUIRE(check(collection, 5));
+                REQUIRE(check(collection.StaticCast<std::int64_t>(), std::int64_t{ 5 }));
+                REQUIRE(check(collection.StaticCast<float>(), 5.0f));
+                REQUIRE(check(collection.StaticCast<double>(), 5.0));
+                REQUIRE(check(collection.Take(3), -1));
+            }
+        }
+    }
+}
@@ -0,0 +1,104 @@
+/// @file CLinqFlatMapTests.cpp
+/// Unit tests for the CLinqFlatMap type and CLinqCollection::ToFlatMap.
+
+import CLinq;
+
+#include <string>
+#include <vector>
+#include "catch.hpp"
+
+SCENARIO("CLinqFlatMaps map distinct keys to values in insertion order")
+{
+    GIVEN("An empty map")
+    {
+        auto map = CLinqFlatMap<std::string, int>();
+
+        THEN("No keys are found")
+        {
+            REQUIRE(0 == map.Count());
+            REQUIRE_FALSE(map.Contains("one"));
+            REQUIRE(nullptr == map.Find("one"));
+            REQUIRE_THROWS_AS(map.At("one"), CLinqException);
+        }
+
+        WHEN("Keys are inserted and assigned")
+        {
+            auto first = map.InsertOrAssign("one", 1);
+            auto second = map.InsertOrAssign("two", 2);
+            auto assigned = map.InsertOrAssign("one", 10);
+
+            THEN("Only new keys are inserted and existing values are replaced")
+            {
+                REQUIRE(first == std::pair<std::size_t, bool>{ 0, true });
+                REQUIRE(second == std::pair<std::size_t, bool>{ 1, true });
+                REQUIRE(assigned == std::pair<std::size_t, bool>{ 0, false });
+                REQUIRE(std::vector<std::string>{ "one", "two" } == map.Keys());
+                REQUIRE(std::vector<int>{ 10, 2 } == map.Values());
+                REQUIRE(10 == map.At("one"));
+                REQUIRE(2 == *map.Find("two"));
+            }
+        }
+    }
+
+    GIVEN("Many keys")
+    {
+        auto map = CLinqFlatMap<int, std::string>();
+        for (auto i = 0; i < 10000; ++i)
+        {
+            map.InsertOrAssign(i * 7, std::to_string(i));
+        }
+
+        THEN("Every key is mapped to its value")
+        {
+            REQUIRE(10000 == map.Count());
+            REQUIRE("9999" == map.At(9999 * 7));
+            REQUIRE("1234" == map.At(1234 * 7));
+            REQUIRE_FALSE(map.Contains(1));
+        }
+    }
+}
+
+SCENARIO("CLinqCollections can be projected to flat maps")
+{
+    GIVEN("A collection with repeated keys")
+    {
+        auto const collection = CLinqCollection<std::string>({ "pear", "fig", "plum", "kiwi", "apple" });
+
+        WHEN("The collection is projected to a flat map")
+        {
+            auto const map = collection.ToFlatMap(
+                [](std::string const& x) { return x.front(); },
+                [](std::string const& x) { return x.size(); });
+
+            THEN("The last value of each key is kept, like ToUnorderedMap")
+            {
+                auto const expected = collection.ToUnorderedMap<char, std::size_t>(
+                    [](std::string const& x) { return x.front(); },
+                    [](std::string const& x) { return x.size(); });
+
+                REQUIRE(std::vector<char>{ 'p', 'f', 'k', 'a' } == map.Keys());
+                REQUIRE(expected.size() == map.Count());
+                for (auto const& [key, value] : expected)
+                {
+                    REQUIRE(value == map.At(key));
+                }
+            }
+        }
+
+        WHEN("The collection is projected to a flat map of bools")
+        {
+            auto const map = collection.ToFlatMap(
+                [](std::string const& x) { return x.front(); },
+                [](std::string const& x) { return x.size() > 3; });
+
+            THEN("The bools can be found by key")
+            {
+                REQUIRE(map.At('p'));
+                REQUIRE_FALSE(map.At('f'));
+                REQUIRE(*map.Find('a'));
+                REQUIRE(nullptr == map.Find('z'));
+                REQUIRE(std::vector<bool>{ true, false, true, true } == std::vector<bool>(map.Values().begin(), map.Values().end()));
+            }
+        }
+    }
+}
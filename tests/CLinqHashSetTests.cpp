@@ -0,0 +1,82 @@
+/// @file CLinqHashSetTests.cpp
+/// Unit tests for the CLinqHashSet type.
+
+import CLinq;
+
+#include <string>
+#include "catch.hpp"
+
+SCENARIO("CLinqHashSets store distinct keys in insertion order")
+{
+    GIVEN("An empty set")
+    {
+        auto set = CLinqHashSet<std::string>();
+
+        THEN("No keys are found")
+        {
+            REQUIRE(0 == set.Count());
+            REQUIRE_FALSE(set.Contains("hello"));
+            REQUIRE(CLinqHashSet<std::string>::npos == set.IndexOf("hello"));
+        }
+
+        WHEN("Keys are inserted")
+        {
+            auto first = set.Insert("hello");
+            auto second = set.Insert("world");
+            auto duplicate = set.Insert("hello");
+
+            THEN("Only new keys are inserted")
+            {
+                REQUIRE(first == std::pair<std::size_t, bool>{ 0, true });
+                REQUIRE(second == std::pair<std::size_t, bool>{ 1, true });
+                REQUIRE(duplicate == std::pair<std::size_t, bool>{ 0, false });
+                REQUIRE(std::vector<std::string>{ "hello", "world" } == set.Keys());
+            }
+        }
+    }
+
+    GIVEN("Many keys")
+    {
+        auto set = CLinqHashSet<int>();
+        for (auto i = 0; i < 10000; ++i)
+        {
+            set.Insert(i * 1024);
+        }
+
+        THEN("Every key can be found at its insertion index after the table grows")
+        {
+            auto allFound = true;
+            for (auto i = 0; i < 10000; ++i)
+            {
+                allFound = allFound && static_cast<std::size_t>(i) == set.IndexOf(i * 1024);
+            }
+
+            REQUIRE(allFound);
+            REQUIRE_FALSE(set.Contains(1));
+        }
+    }
+}
+
+SCENARIO("CLinqHashSets support keys that cannot be hashed")
+{
+    GIVEN("A key type without a std::hash specialization")
+    {
+        struct Key
+        {
+            int value;
+
+            bool operator==(Key const&) const = default;
+        };
+
+        auto set = CLinqHashSet<Key>();
+        set.Insert(Key{ 1 });
+        set.Insert(Key{ 2 });
+        set.Insert(Key{ 1 });
+
+        THEN("Keys are stored distinctly")
+        {
+            REQUIRE(2 == set.Count());
+            REQUIRE(1 == set.IndexOf(Key{ 2 }));
+        }
+    }
+}
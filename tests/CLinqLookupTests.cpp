@@ -0,0 +1,208 @@
+/// @file CLinqLookupTests.cpp
+/// Unit tests for the CLinqLookup type, CLinqCollection::GroupBy and CLinqCollection::ToLookup.
+
+import CLinq;
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+#include "catch.hpp"
+
+SCENARIO("CLinqCollections can be grouped by key")
+{
+    GIVEN("A collection of words")
+    {
+        auto const collection = CLinqCollection<std::string>({ "pear", "fig", "plum", "kiwi", "apple", "peach", "lime" });
+        auto const firstLetter = [](std::string const& x) { return x.front(); };
+
+        WHEN("The collection is grouped by key")
+        {
+            auto const lookup = collection.GroupBy(firstLetter);
+
+            THEN("Groups are ordered by the first appearance of their key")
+            {
+                REQUIRE(5 == lookup.Count());
+                REQUIRE(std::vector<char>{ 'p', 'f', 'k', 'a', 'l' } == lookup.Keys());
+            }
+
+            THEN("Elements keep their order within each group")
+            {
+                REQUIRE(CLinqView<std::string>(lookup['p']) == lookup.At(0));
+                REQUIRE(std::vector<std::string>{ "pear", "plum", "peach" } == lookup['p'].ToVector());
+                REQUIRE(std::vector<std::string>{ "lime" } == lookup['l'].ToVector());
+            }
+
+            THEN("The elements of every group are stored contiguously")
+            {
+                REQUIRE(std::vector<std::string>{ "pear", "plum", "peach", "fig", "kiwi", "apple", "lime" } == lookup.Elements().ToVector());
+                REQUIRE(lookup['f'].begin() == lookup['p'].end());
+            }
+
+            THEN("Missing keys have no elements")
+            {
+                REQUIRE_FALSE(lookup.Contains('z'));
+                REQUIRE_FALSE(lookup['z'].Any());
+                REQUIRE(lookup.Contains('k'));
+            }
+
+            THEN("Groups can be iterated")
+            {
+                auto keys = std::string();
+                auto sizes = std::vector<std::size_t>();
+                for (auto const& group : lookup)
+                {
+                    keys += group.Key();
+                    sizes.push_back(group.Count());
+                }
+
+                REQUIRE("pfkal" == keys);
+                REQUIRE(std::vector<std::size_t>{ 3, 1, 1, 1, 1 } == sizes);
+            }
+
+            THEN("Accessing a group out of range throws")
+            {
+                REQUIRE_THROWS_AS(lookup.At(5), CLinqException);
+            }
+        }
+
+        WHEN("The collection is grouped with an element selector")
+        {
+            auto const lookup = collection.GroupBy(
+                [](std::string const& x) { return x.size(); },
+                [](std::string const& x) { return x.back(); });
+
+            THEN("The projections are grouped")
+            {
+                REQUIRE(std::vector<std::size_t>{ 4, 3, 5 } == lookup.Keys());
+                REQUIRE(std::vector<char>{ 'r', 'm', 'i', 'e' } == lookup[4].ToVector());
+                REQUIRE(std::vector<char>{ 'e', 'h' } == lookup[5].ToVector());
+            }
+        }
+
+        WHEN("The collection is grouped into elements which cannot be default constructed")
+        {
+            auto const lookup = collection.GroupBy(firstLetter, [](std::string const& x) { return std::cref(x); });
+
+            THEN("The elements are grouped")
+            {
+                REQUIRE(3 == lookup['p'].Count());
+                REQUIRE("peach" == lookup['p'].Last().get());
+                REQUIRE("apple" == lookup['a'].First().get());
+            }
+        }
+
+        WHEN("The collection is grouped into bools")
+        {
+            auto const lookup = collection.GroupBy(firstLetter, [](std::string const& x) { return x.size() > 3; });
+
+            THEN("The bools can be viewed and iterated by group")
+            {
+                REQUIRE(std::vector<bool>{ true, true, true } == lookup['p'].ToVector());
+                REQUIRE(std::vector<bool>{ false } == lookup.At(1).ToVector());
+                REQUIRE(std::vector<bool>{ true, true, true, false, true, true, true } == lookup.Elements().ToVector());
+
+                auto trueCounts = std::vector<std::size_t>();
+                for (auto const& group : lookup)
+                {
+                    trueCounts.push_back(group.Count([](bool const x) { return x; }));
+                }
+
+                REQUIRE(std::vector<std::size_t>{ 3, 0, 1, 1, 1 } == trueCounts);
+            }
+        }
+
+        WHEN("The elements are moved into the groups")
+        {
+            auto const lookup = CLinqCollection<std::string>(collection).GroupBy(firstLetter);
+
+            THEN("The groups contain the elements")
+            {
+                REQUIRE(std::vector<std::string>{ "pear", "plum", "peach" } == lookup['p'].ToVector());
+            }
+        }
+    }
+
+    GIVEN("An empty collection")
+    {
+        auto const lookup = CLinqCollection<int>().GroupBy([](int const x) { return x % 2; });
+
+        THEN("There are no groups")
+        {
+            REQUIRE(0 == lookup.Count());
+            REQUIRE(lookup.begin() == lookup.end());
+            REQUIRE_FALSE(lookup.Elements().Any());
+        }
+    }
+
+    GIVEN("A large collection")
+    {
+        auto const collection = CLinqCollection<int>::Range(0, 10000);
+
+        WHEN("The collection is grouped by a key")
+        {
+            auto const lookup = collection.GroupBy([](int const x) { return x % 97; });
+
+            THEN("Every group contains the elements with its key, in order")
+            {
+                REQUIRE(97 == lookup.Count());
+                REQUIRE(10000 == lookup.Elements().Count());
+
+                for (auto const& group : lookup)
+                {
+                    REQUIRE(group.All([&group](int const x) { return x % 97 == group.Key(); }));
+                    REQUIRE(std::is_sorted(group.begin(), group.end()));
+                    REQUIRE(group.Count() == collection.Count([&group](int const x) { return x % 97 == group.Key(); }));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("CLinqCollections can be projected to lookups")
+{
+    GIVEN("A collection with repeated keys")
+    {
+        auto const collection = CLinqCollection<int>({ 15, 21, 32, 16, 25, 37, 11 });
+        auto const tens = [](int const x) { return x / 10; };
+        auto const units = [](int const x) { return x % 10; };
+
+        WHEN("The collection is projected to a lookup")
+        {
+            auto const lookup = collection.ToLookup(tens);
+
+            THEN("Every element is kept under its key")
+            {
+                REQUIRE(std::vector<int>{ 1, 2, 3 } == lookup.Keys());
+                REQUIRE(std::vector<int>{ 15, 16, 11 } == lookup[1].ToVector());
+                REQUIRE(std::vector<int>{ 32, 37 } == lookup[3].ToVector());
+            }
+        }
+
+        WHEN("The collection is projected to a lookup with a value selector")
+        {
+            auto const lookup = collection.ToLookup(tens, units);
+            auto const map = collection.ToMap<int, int>(tens, units);
+
+            THEN("Every value is kept under its key, unlike in a map")
+            {
+                REQUIRE(std::vector<int>{ 5, 6, 1 } == lookup[1].ToVector());
+                REQUIRE(std::vector<int>{ 1, 5 } == lookup[2].ToVector());
+                REQUIRE(1 == map.at(1));
+                REQUIRE(lookup.Elements().Count() == collection.Count());
+            }
+        }
+
+        WHEN("The collection is projected to a lookup of bools")
+        {
+            auto const lookup = collection.ToLookup(tens, [](int const x) { return x % 2 == 1; });
+
+            THEN("Every bool is kept under its key")
+            {
+                REQUIRE(std::vector<bool>{ true, false, true } == lookup[1].ToVector());
+                REQUIRE(std::vector<bool>{ false, true } == lookup.At(2).ToVector());
+                REQUIRE(lookup.Elements().Count() == collection.Count());
+            }
+        }
+    }
+}
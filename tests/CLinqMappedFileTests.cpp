@@ -0,0 +1,112 @@
+/// @file CLinqMappedFileTests.cpp
+/// Unit tests for the CLinqMappedFile type.
+
+import CLinq;
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "catch.hpp"
+
+namespace
+{
+    struct Record
+    {
+        std::int32_t id;
+        float value;
+    };
+
+    std::string WriteFile(std::string const& name, void const* const data, std::size_t const bytes)
+    {
+        auto const path = (std::filesystem::temp_directory_path() / name).string();
+        auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+        file.write(static_cast<char const*>(data), static_cast<std::streamsize>(bytes));
+
+        return path;
+    }
+}
+
+SCENARIO("CLinqMappedFiles expose the elements of a file without copying them")
+{
+    GIVEN("A file of records")
+    {
+        auto records = std::vector<Record>();
+        for (auto i = 0; i < 10000; ++i)
+        {
+            records.push_back(Record{ i, i * 0.5f });
+        }
+
+        auto const path = WriteFile("CLinqMappedFileTests.bin", records.data(), records.size() * sizeof(Record));
+
+        WHEN("The file is mapped")
+        {
+            auto file = CLinqMappedFile<Record>(path);
+
+            THEN("Every record can be read and queried")
+            {
+                REQUIRE(10000 == file.Count());
+                REQUIRE(9999 == file.Last().id);
+                REQUIRE(1234.5f == file[2469].value);
+                REQUIRE(5000 == file.Count([](Record const& x) { return x.id % 2 == 0; }));
+                REQUIRE(std::vector<std::int32_t>{ 9998, 9999 } == file.TakeLast(2).Select([](Record const& x) { return x.id; }).ToVector());
+                REQUIRE(9999 == file.AsQuery().Where([](Record const& x) { return x.value > 4999.0f; }).First().id);
+            }
+
+            THEN("The records are read in place")
+            {
+                REQUIRE(file.Data() == &file[0]);
+                REQUIRE(file.Data() + 1 == file.Skip(1).Data());
+            }
+
+            AND_WHEN("The mapped file is moved")
+            {
+                auto moved = CLinqMappedFile<Record>(std::move(file));
+                moved.Advise(CLinqAccessPattern::Random);
+
+                THEN("The mapping is moved with it")
+                {
+                    REQUIRE(10000 == moved.Count());
+                    REQUIRE(0 == file.Count());
+                    REQUIRE(42 == moved[42].id);
+                }
+            }
+        }
+
+        WHEN("The file is mapped as elements which do not divide its size")
+        {
+            THEN("An exception is thrown")
+            {
+                using Triple = std::array<char, 3>;
+                REQUIRE_THROWS_AS(CLinqMappedFile<Triple>(path), CLinqException);
+            }
+        }
+
+        std::filesystem::remove(path);
+    }
+
+    GIVEN("An empty file")
+    {
+        auto const path = WriteFile("CLinqMappedFileTests.empty.bin", nullptr, 0);
+        auto const file = CLinqMappedFile<std::int64_t>(path);
+
+        THEN("There are no elements")
+        {
+            REQUIRE(0 == file.Count());
+            REQUIRE_FALSE(file.Any());
+        }
+
+        std::filesystem::remove(path);
+    }
+
+    GIVEN("A file which does not exist")
+    {
+        THEN("An exception is thrown")
+        {
+            REQUIRE_THROWS_AS(CLinqMappedFile<int>("CLinqMappedFileTests.missing.bin"), CLinqException);
+        }
+    }
+}
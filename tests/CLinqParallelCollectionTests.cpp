@@ -0,0 +1,149 @@
+/// @file CLinqParallelCollectionTests.cpp
+/// Unit tests for the CLinqParallelCollection type.
+
+import CLinq;
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "catch.hpp"
+
+SCENARIO("CLinqParallelCollections evaluate CLinq methods across threads in order")
+{
+    GIVEN("A collection large enough to be split into chunks")
+    {
+        auto collection = CLinqCollection<int>::Range(0, 100000);
+        auto parallel = collection.AsParallel(8);
+
+        THEN("The degree of parallelism is configurable")
+        {
+            REQUIRE(8 == parallel.DegreeOfParallelism());
+            REQUIRE(2 == parallel.WithDegreeOfParallelism(2).DegreeOfParallelism());
+            REQUIRE(1 == parallel.WithDegreeOfParallelism(0).DegreeOfParallelism());
+        }
+
+        WHEN("Elements are filtered and projected")
+        {
+            auto isEven = [](int const i) { return i % 2 == 0; };
+            auto projectionFunction = [](int const i) { return std::to_string(i); };
+            auto actual = parallel.Where(isEven).Select(projectionFunction).ToCollection();
+
+            THEN("The results match sequential evaluation")
+            {
+                REQUIRE(collection.Where(isEven).Select(projectionFunction) == actual);
+            }
+        }
+
+        WHEN("Elements are counted and matched")
+        {
+            THEN("The results match sequential evaluation")
+            {
+                REQUIRE(33334 == parallel.Count([](int const i) { return i % 3 == 0; }));
+                REQUIRE(100000 == parallel.Count());
+                REQUIRE(parallel.All([](int const i) { return i >= 0; }));
+                REQUIRE_FALSE(parallel.All([](int const i) { return i < 99999; }));
+                REQUIRE(parallel.Any([](int const i) { return i == 99999; }));
+                REQUIRE_FALSE(parallel.Any([](int const i) { return i < 0; }));
+            }
+        }
+
+        WHEN("Elements are aggregated")
+        {
+            auto append = [](std::string accumulated, int const i) { return accumulated += std::to_string(i % 10); };
+            auto concatenate = [](std::string left, std::string const& right) { return left += right; };
+            auto expected = collection.Aggregate(std::string(), append);
+
+            THEN("The results match sequential evaluation")
+            {
+                REQUIRE(4999950000LL == parallel.Aggregate(0LL, [](long long const sum, int const i) { return sum + i; }, std::plus<>()));
+                REQUIRE(expected == parallel.Aggregate(std::string(), append, concatenate));
+                REQUIRE(expected == parallel.WithDegreeOfParallelism(5).Aggregate(std::string(), append, concatenate));
+                REQUIRE(expected.size() == parallel.Aggregate(std::string(), append, concatenate, [](std::string const& x) { return x.size(); }));
+            }
+        }
+
+        WHEN("Running results are computed")
+        {
+            auto concatenate = [](std::string const& left, std::string const& right) { return left + right; };
+            auto strings = collection.Take(3000).Select([](int const i) { return std::to_string(i % 10); });
+            auto parallelStrings = strings.AsParallel(3);
+            auto wide = collection.StaticCast<std::int64_t>();
+
+            THEN("The results match sequential evaluation")
+            {
+                REQUIRE(wide.Scan(std::int64_t{ 7 }, std::plus<>()) == wide.AsParallel(8).Scan(7, std::plus<>()).ToCollection());
+                REQUIRE(wide.ExclusiveScan(std::int64_t{ 7 }, std::plus<>()) == wide.AsParallel(8).ExclusiveScan(7, std::plus<>()).ToCollection());
+                REQUIRE(collection.Scan(0, CLinqMaximum()) == parallel.WithDegreeOfParallelism(5).Scan(0, CLinqMaximum()).ToCollection());
+                REQUIRE(strings.Scan(std::string("x"), concatenate) == parallelStrings.Scan("x", concatenate).ToCollection());
+                REQUIRE(strings.ExclusiveScan(std::string("x"), concatenate) == parallelStrings.ExclusiveScan("x", concatenate).ToCollection());
+            }
+        }
+
+        WHEN("Elements are cast")
+        {
+            THEN("The results match sequential evaluation")
+            {
+                REQUIRE(collection.StaticCast<double>() == parallel.StaticCast<double>().ToCollection());
+            }
+        }
+
+        WHEN("A match function throws")
+        {
+            THEN("The exception is rethrown on the calling thread")
+            {
+                REQUIRE_THROWS_AS(
+                    parallel.Where([](int const i) -> bool { if (i == 70000) { throw std::runtime_error("error"); } return true; }),
+                    std::runtime_error);
+                REQUIRE_THROWS_AS(
+                    parallel.Aggregate(0, [](int const sum, int const i) { if (i == 30000) { throw std::runtime_error("error"); } return sum + i % 2; }, std::plus<>()),
+                    std::runtime_error);
+                REQUIRE_THROWS_AS(
+                    parallel.Scan(0, [](int const sum, int const i) { if (i == 30000) { throw std::runtime_error("error"); } return sum + i; }),
+                    std::runtime_error);
+            }
+        }
+    }
+}
+
+SCENARIO("CLinqParallelCollections compute set operations in order")
+{
+    GIVEN("Collections with many duplicates")
+    {
+        auto collection1 = CLinqCollection<int>::Range(0, 50000).Select([](int const i) { return (i * 7) % 1000; });
+        auto collection2 = CLinqCollection<int>::Range(500, 5000).Select([](int const i) { return i % 2000; });
+        auto parallel = collection1.AsParallel(4);
+
+        THEN("The results match sequential evaluation")
+        {
+            REQUIRE(collection1.Distinct() == parallel.Distinct().ToCollection());
+            REQUIRE(collection1.Except(collection2) == parallel.Except(collection2).ToCollection());
+            REQUIRE(collection1.Intersection(collection2) == parallel.Intersection(collection2).ToCollection());
+            REQUIRE(collection1.Union(collection2) == parallel.Union(collection2).ToCollection());
+        }
+
+        WHEN("The other collection uses a different allocator")
+        {
+            auto arena = CLinqArena();
+            auto const arenaCollection = collection2.AsView().ToCollection(CLinqArenaAllocator<int>(arena));
+
+            THEN("The results match sequential evaluation")
+            {
+                REQUIRE(collection1.Except(collection2) == parallel.Except(arenaCollection).ToCollection());
+                REQUIRE(collection1.Intersection(collection2) == parallel.Intersection(arenaCollection).ToCollection());
+                REQUIRE(collection1.Union(collection2) == parallel.Union(arenaCollection).ToCollection());
+            }
+        }
+    }
+
+    GIVEN("A temporary collection")
+    {
+        auto parallel = CLinqCollection<int>({ 3, 1, 3, 2 }).AsParallel();
+
+        THEN("The parallel collection owns the elements")
+        {
+            REQUIRE(std::vector<int>{ 3, 1, 2 } == parallel.Distinct().ToVector());
+        }
+    }
+}
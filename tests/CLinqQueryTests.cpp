@@ -0,0 +1,347 @@
+/// @file CLinqQueryTests.cpp
+/// Unit tests for the CLinqQuery type.
+
+import CLinq;
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "catch.hpp"
+
+SCENARIO("CLinqQueries are evaluated lazily")
+{
+    GIVEN("A collection and a counting projection")
+    {
+        auto collection = CLinqCollection<int>({ 1, 2, 3, 4, 5, 6 });
+        auto evaluations = 0;
+        auto projectionFunction = [&evaluations](int const i) { ++evaluations; return i * 10; };
+
+        WHEN("A query is composed but not materialised")
+        {
+            auto query = collection.AsQuery().Select(projectionFunction);
+
+            THEN("No elements are evaluated until the query is materialised")
+            {
+                REQUIRE(0 == evaluations);
+                REQUIRE(std::vector<int>{ 10, 20, 30, 40, 50, 60 } == query.ToVector());
+                REQUIRE(6 == evaluations);
+            }
+        }
+
+        WHEN("The first element of a query is materialised")
+        {
+            auto first = collection.AsQuery().Select(projectionFunction).First();
+
+            THEN("Only the first element is evaluated")
+            {
+                REQUIRE(10 == first);
+                REQUIRE(1 == evaluations);
+            }
+        }
+
+        WHEN("A filtered, projected and paged query is materialised")
+        {
+            auto actual = collection.AsQuery()
+                .Where([](int const i) { return i % 2 == 0; })
+                .Select(projectionFunction)
+                .Take(2)
+                .ToVector();
+
+            THEN("Each required element is evaluated once")
+            {
+                REQUIRE(std::vector<int>{ 20, 40 } == actual);
+                REQUIRE(2 == evaluations);
+            }
+        }
+    }
+}
+
+SCENARIO("CLinqQueries can be skipped and taken")
+{
+    GIVEN("A query")
+    {
+        auto collection = CLinqCollection<int>({ 1, 2, 3, 4, 5 });
+        auto query = collection.AsQuery();
+
+        WHEN("Elements are skipped and taken")
+        {
+            THEN("The expected elements are returned")
+            {
+                REQUIRE(CLinqCollection<int>({ 2, 3 }) == query.Skip(1).Take(2).ToCollection());
+            }
+        }
+
+        WHEN("More elements are skipped or taken than exist in the query")
+        {
+            THEN("The query is truncated")
+            {
+                REQUIRE_FALSE(query.Skip(10).Any());
+                REQUIRE(5 == query.Take(10).Count());
+            }
+        }
+
+        WHEN("Elements are skipped and taken while a condition is true")
+        {
+            auto matchFunction = [](int const i) { return i < 3; };
+
+            THEN("The expected elements are returned")
+            {
+                REQUIRE(std::vector<int>{ 3, 4, 5 } == query.SkipWhile(matchFunction).ToVector());
+                REQUIRE(std::vector<int>{ 1, 2 } == query.TakeWhile(matchFunction).ToVector());
+            }
+        }
+
+        WHEN("The elements with the least and greatest keys are taken")
+        {
+            auto keySelector = [](int const i) { return i % 3; };
+
+            THEN("The elements are taken in order of key, and ties keep their order")
+            {
+                REQUIRE(std::vector<int>{ 3, 1, 4 } == query.TopBy(keySelector, 3).ToVector());
+                REQUIRE(std::vector<int>{ 2, 5, 1 } == query.TopByDescending(keySelector, 3).ToVector());
+            }
+
+            THEN("Taking more elements than exist in the query takes every element")
+            {
+                REQUIRE(std::vector<int>{ 5, 4, 3, 2, 1 } == query.TopByDescending([](int const i) { return i; }, 10).ToVector());
+                REQUIRE_FALSE(query.TopBy(keySelector, 0).Any());
+            }
+        }
+    }
+}
+
+SCENARIO("CLinqQueries can be flattened")
+{
+    GIVEN("A query over collections")
+    {
+        auto collection = CLinqCollection<std::vector<int>>({ { 1, 2 }, {}, { 3 }, { 4, 5, 6 } });
+        auto query = collection.AsQuery().SelectMany([](std::vector<int> const& inner) -> std::vector<int> const& { return inner; });
+
+        THEN("The inner elements are enumerated in order")
+        {
+            REQUIRE(std::vector<int>{ 1, 2, 3, 4, 5, 6 } == query.ToVector());
+            REQUIRE(std::vector<int>{ 3, 4 } == query.Skip(2).Take(2).ToVector());
+        }
+
+        THEN("The inner elements can be projected with their element")
+        {
+            auto const sizes = collection.AsQuery()
+                .SelectMany(
+                    [](std::vector<int> const& inner) -> std::vector<int> const& { return inner; },
+                    [](std::vector<int> const& inner, int const i) { return i * 10 + static_cast<int>(inner.size()); })
+                .ToVector();
+
+            REQUIRE(std::vector<int>{ 12, 22, 31, 43, 53, 63 } == sizes);
+        }
+    }
+
+    GIVEN("A query over an unbounded generator of ranges")
+    {
+        auto query = CLinq::Range(1, 1'000'000'000).SelectMany([](int const i) { return std::vector<int>(static_cast<std::size_t>(i), i); });
+
+        THEN("The ranges are only produced as they are needed")
+        {
+            REQUIRE(std::vector<int>{ 1, 2, 2, 3, 3, 3, 4 } == query.Take(7).ToVector());
+        }
+    }
+}
+
+SCENARIO("CLinqQueries can be materialised")
+{
+    GIVEN("A query")
+    {
+        auto collection = CLinqCollection<int>({ 1, 2, 3, 4 });
+        auto query = collection.AsQuery().Where([](int const i) { return i > 1; });
+
+        THEN("Predicates are evaluated over the query")
+        {
+            REQUIRE(query.All([](int const i) { return i > 1; }));
+            REQUIRE(query.Any([](int const i) { return i == 4; }));
+            REQUIRE(query.Contains(3));
+            REQUIRE_FALSE(query.Contains(1));
+            REQUIRE(2 == query.Count([](int const i) { return i % 2 == 0; }));
+        }
+
+        THEN("The query can be aggregated")
+        {
+            REQUIRE(9 == query.Aggregate(0, [](int const sum, int const i) { return sum + i; }));
+            REQUIRE(24.0 == query.Aggregate(1, std::multiplies<>(), [](int const product) { return product * 1.0; }));
+        }
+
+        THEN("The query can be materialised more than once")
+        {
+            REQUIRE(3 == query.Count());
+            REQUIRE(3 == query.Count());
+        }
+
+        THEN("The query can be cast")
+        {
+            REQUIRE(std::vector<double>{ 2.0, 3.0, 4.0 } == query.StaticCast<double>().ToVector());
+        }
+    }
+
+    GIVEN("An empty query")
+    {
+        auto collection = CLinqCollection<int>();
+
+        THEN("Accessing the first element throws")
+        {
+            REQUIRE_THROWS_AS(collection.AsQuery().First(), CLinqException);
+        }
+    }
+}
+
+SCENARIO("CLinqQueries can stream the lines of streams and files")
+{
+    GIVEN("A stream of lines")
+    {
+        auto stream = std::istringstream("alpha\nbeta\r\n\ngamma");
+        auto query = CLinq::FromLines(stream);
+
+        THEN("Every line is enumerated without its line ending")
+        {
+            REQUIRE(std::vector<std::string>{ "alpha", "beta", "", "gamma" } == query.ToVector());
+        }
+    }
+
+    GIVEN("A file larger than the chunk size")
+    {
+        auto const path = (std::filesystem::temp_directory_path() / "CLinqQueryTests.lines.txt").string();
+        {
+            auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+            for (auto i = 0; i < 100000; ++i)
+            {
+                file << "line " << i << '\n';
+            }
+
+            file << std::string(200000, 'x') << '\n';
+        }
+
+        WHEN("Lines are queried")
+        {
+            auto query = CLinq::FromFile(path);
+
+            THEN("Every line is enumerated, including lines longer than a chunk")
+            {
+                REQUIRE(100001 == query.Count());
+                REQUIRE("line 0" == query.First());
+                REQUIRE(200000 == query.Skip(100000).First().size());
+                REQUIRE(10000 == query.Count([](std::string const& line) { return line.ends_with('7'); }));
+            }
+        }
+
+        WHEN("Records are parsed from the lines")
+        {
+            auto query = CLinq::FromFile(path, [](std::string const& line) { return line.size(); })
+                .Where([](std::size_t const length) { return length < 100; });
+
+            THEN("The records can be aggregated")
+            {
+                REQUIRE(100000 == query.Count());
+                REQUIRE(6 == query.First());
+                REQUIRE(988890 == query.Aggregate(std::size_t{ 0 }, std::plus<>()));
+            }
+        }
+
+        std::filesystem::remove(path);
+    }
+
+    GIVEN("A file which does not exist")
+    {
+        auto query = CLinq::FromFile("CLinqQueryTests.missing.txt");
+
+        THEN("Evaluating the query throws")
+        {
+            REQUIRE_THROWS_AS(query.Count(), CLinqException);
+        }
+    }
+}
+
+namespace
+{
+    CLinqGenerator<long long> Squares()
+    {
+        for (long long i = 0;; ++i)
+        {
+            co_yield i * i;
+        }
+    }
+
+    CLinqGenerator<int> ThrowAfter(int const count)
+    {
+        for (auto i = 0; i < count; ++i)
+        {
+            co_yield i;
+        }
+
+        throw std::runtime_error("error");
+    }
+}
+
+SCENARIO("CLinqQueries can produce their elements on demand")
+{
+    GIVEN("An unbounded generator")
+    {
+        auto query = CLinq::FromGenerator(Squares());
+
+        THEN("Only the values needed are produced")
+        {
+            REQUIRE(std::vector<long long>{ 1, 9, 25 } == query.Where([](long long const x) { return x % 2 == 1; }).Take(3).ToVector());
+        }
+    }
+
+    GIVEN("A generator which throws")
+    {
+        THEN("The exception is rethrown to the caller")
+        {
+            REQUIRE(3 == CLinq::FromGenerator(ThrowAfter(5)).Take(3).Count());
+            REQUIRE_THROWS_AS(CLinq::FromGenerator(ThrowAfter(5)).Count(), std::runtime_error);
+        }
+    }
+
+    GIVEN("A range too large to store")
+    {
+        auto query = CLinq::Range(0LL, 1'000'000'000'000);
+
+        THEN("Elements are produced as the query is evaluated")
+        {
+            REQUIRE(10'000'004 == query.Where([](long long const x) { return x > 10'000'000 && x % 7 == 0; }).First());
+            REQUIRE(std::vector<long long>{ 0, 1, 2 } == query.Take(3).ToVector());
+            REQUIRE(std::vector<long long>{ 0, 1, 2 } == query.Take(3).ToVector());
+        }
+    }
+
+    GIVEN("Repeated and empty ranges")
+    {
+        THEN("The elements match the equivalent collections")
+        {
+            REQUIRE(CLinqCollection<std::string>::Repeat("a", 3).ToVector() == CLinq::Repeat(std::string("a"), 3).ToVector());
+            REQUIRE(CLinqCollection<int>::Range(5, 4).ToVector() == CLinq::Range(5, 4).ToVector());
+            REQUIRE_FALSE(CLinq::Range(5, 0).Any());
+        }
+    }
+
+    GIVEN("A query")
+    {
+        auto collection = CLinqCollection<int>({ 1, 2, 3, 4 });
+        auto query = collection.AsQuery().Select([](int const i) { return i * 10; });
+
+        WHEN("The query is evaluated into a generator")
+        {
+            auto values = std::vector<int>();
+            for (auto const value : query.ToGenerator())
+            {
+                values.push_back(value);
+            }
+
+            THEN("The generator produces the elements of the query")
+            {
+                REQUIRE(std::vector<int>{ 10, 20, 30, 40 } == values);
+            }
+        }
+    }
+}
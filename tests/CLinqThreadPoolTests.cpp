@@ -0,0 +1,90 @@
+/// @file CLinqThreadPoolTests.cpp
+/// Unit tests for the CLinqThreadPool type.
+
+import CLinq;
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "catch.hpp"
+
+SCENARIO("CLinqThreadPools run batches of tasks")
+{
+    GIVEN("A pool with worker threads")
+    {
+        auto pool = CLinqThreadPool(3);
+
+        THEN("It has the given number of workers")
+        {
+            REQUIRE(3 == pool.ThreadCount());
+        }
+
+        WHEN("A batch is run")
+        {
+            auto calls = std::vector<std::atomic<int>>(1000);
+            pool.Run(calls.size(), [&calls](std::size_t const index) { calls[index].fetch_add(1); });
+
+            THEN("Every task is run exactly once")
+            {
+                for (auto& count : calls)
+                {
+                    REQUIRE(1 == count.load());
+                }
+            }
+        }
+
+        WHEN("Batches are run from inside tasks")
+        {
+            auto total = std::atomic<int>(0);
+            pool.Run(8, [&pool, &total](std::size_t)
+            {
+                pool.Run(8, [&total](std::size_t const index) { total.fetch_add(static_cast<int>(index)); });
+            });
+
+            THEN("Every nested task is run")
+            {
+                REQUIRE(8 * 28 == total.load());
+            }
+        }
+
+        WHEN("Tasks throw")
+        {
+            auto calls = std::atomic<int>(0);
+            auto const run = [&]
+            {
+                pool.Run(100, [&calls](std::size_t const index)
+                {
+                    calls.fetch_add(1);
+                    if (index == 70 || index == 30)
+                    {
+                        throw std::out_of_range(std::to_string(index));
+                    }
+                });
+            };
+
+            THEN("Every task still runs and the exception of the lowest index is rethrown")
+            {
+                REQUIRE_THROWS_WITH(run(), "30");
+                REQUIRE(100 == calls.load());
+            }
+        }
+    }
+
+    GIVEN("A pool without worker threads")
+    {
+        auto pool = CLinqThreadPool(0);
+
+        WHEN("A batch is run")
+        {
+            auto sum = 0;
+            pool.Run(10, [&sum](std::size_t const index) { sum += static_cast<int>(index); });
+
+            THEN("The tasks are run on the calling thread")
+            {
+                REQUIRE(45 == sum);
+            }
+        }
+    }
+}
@@ -0,0 +1,116 @@
+/// @file CLinqViewTests.cpp
+/// Unit tests for the CLinqView type.
+
+import CLinq;
+
+#include <vector>
+#include "catch.hpp"
+
+SCENARIO("CLinqViews can be sliced without copying")
+{
+    GIVEN("A view over a collection")
+    {
+        auto collection = CLinqCollection<int>({ 1, 2, 3, 4, 5, 6 });
+        auto view = collection.AsView();
+
+        THEN("The view refers to the elements of the collection")
+        {
+            REQUIRE(6 == view.Count());
+            REQUIRE(&collection[0] == view.Data());
+        }
+
+        WHEN("The view is paged with Skip and Take")
+        {
+            auto page = view.Skip(2).Take(2);
+
+            THEN("The page refers to the elements of the collection")
+            {
+                REQUIRE(&collection[2] == page.Data());
+                REQUIRE(CLinqCollection<int>({ 3, 4 }) == page.ToCollection());
+            }
+        }
+
+        WHEN("The view is sliced from the back")
+        {
+            THEN("The expected elements are viewed")
+            {
+                REQUIRE(std::vector<int>{ 1, 2, 3, 4 } == view.SkipLast(2).ToVector());
+                REQUIRE(std::vector<int>{ 5, 6 } == view.TakeLast(2).ToVector());
+            }
+        }
+
+        WHEN("The view is sliced while a condition is true")
+        {
+            auto matchFunction = [](int const i) { return i < 3; };
+
+            THEN("The expected elements are viewed")
+            {
+                REQUIRE(std::vector<int>{ 3, 4, 5, 6 } == view.SkipWhile(matchFunction).ToVector());
+                REQUIRE(std::vector<int>{ 1, 2 } == view.TakeWhile(matchFunction).ToVector());
+            }
+        }
+
+        WHEN("More elements are skipped or taken than are viewed")
+        {
+            THEN("Exception is thrown")
+            {
+                REQUIRE_THROWS_AS(view.Skip(7), CLinqException);
+                REQUIRE_THROWS_AS(view.SkipLast(7), CLinqException);
+                REQUIRE_THROWS_AS(view.Take(7), CLinqException);
+                REQUIRE_THROWS_AS(view.TakeLast(7), CLinqException);
+            }
+        }
+
+        WHEN("The view is chunked")
+        {
+            auto chunks = view.Skip(1).Chunk(2);
+
+            THEN("Each chunk refers to the elements of the collection")
+            {
+                REQUIRE(3 == chunks.Count());
+                REQUIRE(&collection[1] == chunks[0].Data());
+                REQUIRE(&collection[5] == chunks[2].Data());
+                REQUIRE(std::vector<int>{ 6 } == chunks[2].ToVector());
+            }
+        }
+    }
+}
+
+SCENARIO("CLinqViews support CLinq methods")
+{
+    GIVEN("A view")
+    {
+        auto collection = CLinqCollection<int>({ 1, 2, 3, 4 });
+        auto view = collection.AsView().Skip(1);
+
+        THEN("Elements can be accessed")
+        {
+            REQUIRE(2 == view.First());
+            REQUIRE(4 == view.Last());
+            REQUIRE(3 == view.At(1));
+            REQUIRE(4 == view.Skip(2).Single());
+            REQUIRE_THROWS_AS(view.At(3), CLinqException);
+            REQUIRE_THROWS_AS(view.Single(), CLinqException);
+            REQUIRE_THROWS_AS(view.Skip(3).First(), CLinqException);
+        }
+
+        THEN("Elements can be queried")
+        {
+            REQUIRE(view.All([](int const i) { return i > 1; }));
+            REQUIRE(view.Any([](int const i) { return i == 4; }));
+            REQUIRE(view.Contains(3));
+            REQUIRE_FALSE(view.Contains(1));
+            REQUIRE(2 == view.Count([](int const i) { return i % 2 == 0; }));
+            REQUIRE(CLinqCollection<int>({ 2, 4 }) == view.Where([](int const i) { return i % 2 == 0; }));
+            REQUIRE(CLinqCollection<int>({ 4, 6, 8 }) == view.Select([](int const i) { return i * 2; }));
+        }
+
+        THEN("Views are compared element-wise")
+        {
+            auto other = CLinqCollection<int>({ 2, 3, 4 });
+
+            REQUIRE(view == other.AsView());
+            REQUIRE_FALSE(view == other.AsView().Take(2));
+        }
+    }
+}